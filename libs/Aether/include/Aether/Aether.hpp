@@ -7,6 +7,7 @@
  */
 
 // Include all relevant hpp's
+#include "Aether/base/Stack.hpp"
 #include "Aether/Display.hpp"
 #include "Aether/horizon/button/FilledButton.hpp"
 #include "Aether/horizon/list/ListComment.hpp"
@@ -14,6 +15,7 @@
 #include "Aether/horizon/list/ListHeadingHelp.hpp"
 #include "Aether/horizon/list/ListOption.hpp"
 #include "Aether/horizon/list/ListSeparator.hpp"
+#include "Aether/horizon/list/VirtualList.hpp"
 #include "Aether/horizon/menu/Menu.hpp"
 #include "Aether/horizon/menu/MenuOption.hpp"
 #include "Aether/horizon/menu/MenuSeparator.hpp"
@@ -25,7 +27,10 @@
 #include "Aether/primary/Animation.hpp"
 #include "Aether/primary/Ellipse.hpp"
 #include "Aether/primary/Image.hpp"
+#include "Aether/primary/SpriteAnimation.hpp"
+#include "Aether/primary/StreamAnimation.hpp"
 #include "Aether/ThreadPool.hpp"
 #include "Aether/utils/Theme.hpp"
+#include "Aether/utils/Trace.hpp"
 
 #endif
\ No newline at end of file
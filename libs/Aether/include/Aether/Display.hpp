@@ -26,6 +26,8 @@ namespace Aether {
             bool loop_;
             /** @brief Indicator on whether the FPS should be displayed */
             bool fps_;
+            /** @brief Indicator on whether the first frame has been shown */
+            bool shownFrame;
             /** @brief Colour to clear screen with */
             Colour bg;
             /** @brief Texture (image) to clear screen with */
@@ -38,8 +40,12 @@ namespace Aether {
             int heldTime;
             /** @brief Time delay before button is considered held instead of new button press */
             int holdDelay_;
+            /** @brief Time of the last input event (in ticks), the highlight only pulses for a while after it */
+            uint32_t lastInput;
             /** @brief Vector of overlays, drawn from start -> end but only last one gets events! */
             std::vector<Overlay *> overlays;
+            /** @brief Snapshot of the background + screen drawn while overlays are shown (nullptr if not taken) */
+            SDL_Texture * screenSnapshot;
             /** @brief Pointer to current screen to draw */
             Screen * screen;
             /** @brief Pointer to screen to change to after loop */
@@ -64,6 +70,25 @@ namespace Aether {
             using Element::update;
             using Element::render;
 
+            /**
+             * @brief Pass an event to the top overlay (or screen if there are none)
+             *
+             * @param e event to pass
+             */
+            void dispatchEvent(InputEvent * e);
+
+            /**
+             * @brief Determine how long the loop can sleep for as nothing on screen is changing
+             *
+             * @return time to wait for input (in ms), or 0 if the next frame is needed straight away
+             */
+            int idleWait();
+
+            /**
+             * @brief Destroy the screen snapshot (so a new one is taken if needed)
+             */
+            void dropSnapshot();
+
         public:
             /**
              * @brief Construct a new Display object
@@ -135,6 +160,8 @@ namespace Aether {
 
             /**
              * @brief Add new overlay to current display
+             * @note While overlays are shown the screen below is not updated or re-rendered,
+             * instead a snapshot of it taken when the first overlay opens is drawn
              *
              * @param o overlay to add
              */
@@ -182,12 +209,20 @@ namespace Aether {
 
             /**
              * @brief Executes the main loop (events + rendering)
+             * @note When nothing is animating the loop blocks until input arrives
+             * (or a short timeout passes) instead of drawing identical frames
              *
              * @return true while the app's main loop is running
              * @return false when the app's main loop is terminated
              */
             bool loop();
 
+            /**
+             * @brief Wake the loop if it is waiting for input (so a new frame is drawn)
+             * @note This is safe to call from any thread (background tasks call it as they finish)
+             */
+            static void wake();
+
             /**
              * @brief Indicates app to exit by turning loop value to false
              */
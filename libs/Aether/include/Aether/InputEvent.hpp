@@ -46,6 +46,15 @@ namespace Aether {
              */
             InputEvent(SDL_Event event);
 
+            /**
+             * @brief Construct a new button Input Event object directly (without going through SDL)
+             *
+             * @param type type of event (ButtonPressed or ButtonReleased)
+             * @param button button the event is for
+             * @param id ID of the event
+             */
+            InputEvent(EventType type, Button button, int id);
+
             /**
              * @brief Getter function to get event type
              * 
@@ -1,21 +1,44 @@
 #ifndef AETHER_SCREEN_HPP
 #define AETHER_SCREEN_HPP
 
+#include <atomic>
 #include "Aether/base/Container.hpp"
-#include <unordered_map>
+#include <future>
+#include <memory>
 
 namespace Aether {
     /**
      * @brief A class that represents a screen layout
      * Stores all screen elements for a specific screen.
+     *
+     * Heavy initialisation (network, file scans, etc.) can be run with runAsync()
+     * so the screen can show placeholder elements straight away.
      */
     class Screen : public Container {
         private:
-            /** @brief Mappings for button presses to callback functions */
-            std::unordered_map<Button, std::function<void()> > pressFuncs;
+            /**
+             * @brief Struct storing a background task and what to call once it finishes
+             */
+            struct AsyncTask {
+                std::future<void> future;       /**< Future for task running on another thread */
+                std::function<void()> done;     /**< Function to call on the main thread once finished */
+                std::shared_ptr<std::atomic<bool> > finished;  /**< Set by the task as it returns (before the display is woken) */
+            };
+
+            /** @brief Background tasks which haven't been completed yet */
+            std::vector<AsyncTask> tasks;
+
+            /** @brief Whether anything on the screen has changed since checkChanged() was last called */
+            bool changed_;
 
-            /** @brief Mappings for button releases to callback functions */
-            std::unordered_map<Button, std::function<void()> > releaseFuncs;
+            /** @brief Arena which elements created in onLoad() and task completions are allocated from */
+            ElementArena arena_;
+
+            /** @brief Mappings for button presses to callback functions (indexed by button) */
+            std::function<void()> pressFuncs[Button::NO_BUTTON];
+
+            /** @brief Mappings for button releases to callback functions (indexed by button) */
+            std::function<void()> releaseFuncs[Button::NO_BUTTON];
 
         public:
             /**
@@ -23,8 +46,17 @@ namespace Aether {
              */
             Screen();
 
+            /**
+             * @brief Returns the screen's element arena
+             * @note Elements created from it must only be added to this screen
+             *
+             * @return arena elements created while (re)building the screen can be allocated from
+             */
+            ElementArena & arena();
+
             /**
              * @brief Callback function when the screen is loaded
+             * @note Elements created here are allocated from the screen's arena
              */
             virtual void onLoad();
 
@@ -61,6 +93,52 @@ namespace Aether {
              * @return false if event was not handled
              */
             bool handleEvent(InputEvent *event);
+
+            /**
+             * @brief Run a function on a separate thread, then call another on the main
+             * thread (from pollTasks()) once it has finished
+             * @note Tasks are polled every frame, even while the screen is covered by an overlay.
+             * The display is woken when a task finishes, so it can sleep while tasks run.
+             * Destroying the screen waits for running tasks. Elements created by done are
+             * allocated from the screen's arena.
+             *
+             * @param task function to run in the background (must not touch elements!)
+             * @param done function to call on the main thread afterwards (can be nullptr)
+             */
+            void runAsync(std::function<void()> task, std::function<void()> done);
+
+            /**
+             * @brief Returns whether any background tasks have yet to complete
+             *
+             * @return true if tasks are running
+             * @return false otherwise
+             */
+            bool loading();
+
+            /**
+             * @brief Calls completion functions for finished background tasks
+             * @note Called by the display every frame
+             */
+            void pollTasks();
+
+            /**
+             * @brief Also remembers the change for checkChanged()
+             */
+            void invalidate();
+
+            /**
+             * @brief Returns whether the screen has changed since the last call
+             * (used to redraw the snapshot shown behind overlays)
+             *
+             * @return true if anything has been invalidated
+             * @return false otherwise
+             */
+            bool checkChanged();
+
+            /**
+             * @brief Destroy the Screen object (deleting its elements before their arena)
+             */
+            ~Screen();
     };
 };
 
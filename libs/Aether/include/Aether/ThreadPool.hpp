@@ -42,6 +42,15 @@ namespace Aether {
          * @note Called internally - you shouldn't need to call it yourself!
          */
         void process();
+
+        /**
+         * @brief Returns whether there are no queued or running tasks
+         * @note Called internally - you shouldn't need to call it yourself!
+         *
+         * @return true if idle
+         * @return false if tasks are queued or running
+         */
+        bool idle();
     };
 };
 
@@ -2,6 +2,7 @@
 #define AETHER_CONTAINER_HPP
 
 #include "Aether/base/Element.hpp"
+#include "Aether/utils/SpatialIndex.hpp"
 
 namespace Aether {
     /**
@@ -12,11 +13,68 @@ namespace Aether {
      *
      * It allows the selection to automatically move between elements without
      * having to specify which ones are next to which.
+     *
+     * Children are kept in a spatial index so that both d-pad navigation and
+     * touch hit-testing only look at children near the relevant point.
+     * @note Touches are only passed to children whose bounds contain the touch point.
+     *
+     * A container can also be cached, in which case its children are rendered
+     * once into a texture which is drawn each frame until something inside changes.
      */
     class Container : public Element {
+        private:
+            /** @brief Grid of children (in co-ordinates relative to the child origin) */
+            SpatialIndex index;
+            /** @brief Child which handled the last touch press (receives the following move events) */
+            Element * touched;
+            /** @brief Reused vector of children under the touch point */
+            std::vector<Element *> touchHits;
+            /** @brief Whether children are rendered into a cached layer */
+            bool cached_;
+            /** @brief Cached layer texture (nullptr until first needed) */
+            SDL_Texture * layer;
+            /** @brief Whether the layer needs to be redrawn */
+            bool layerDirty;
+            /** @brief Whether index updates are paused (see pauseIndex()) */
+            bool indexPaused;
+            /** @brief Whether a child was added or moved while index updates were paused */
+            bool indexStale;
+
+            /**
+             * @brief Update the child's rectangle in the spatial index
+             *
+             * @param e child to (re)index
+             */
+            void indexElement(Element * e);
+
         protected:
              void addElementAt(Element * e, size_t i);
 
+            /**
+             * @brief Move focus to the nearest selectable child in the given direction
+             *
+             * @param b direction to move in (DPAD_*)
+             * @return true if valid element found to move to
+             * @return false otherwise
+             */
+            bool moveFocus(Button b);
+
+            /**
+             * @brief Stop updating the spatial index as children are added or moved
+             * (e.g. while many children are repositioned at once)
+             */
+            void pauseIndex();
+
+            /**
+             * @brief Resume updating the spatial index, rebuilding it in one pass
+             * if any children were added or moved while paused
+             */
+            void resumeIndex();
+
+            void childChanged(Element * e);
+            void childRemoved(Element * e);
+            void invalidate();
+
         public:
             /**
              * @brief Construct a new Container object
@@ -38,20 +96,34 @@ namespace Aether {
              */
             void setInactive();
 
+            /**
+             * @brief Returns whether the container renders from a cached layer
+             *
+             * @return true if cached
+             * @return false otherwise
+             */
+            bool cached();
+
+            /**
+             * @brief Set whether to render children once into a cached layer (texture) and reuse it
+             * until something inside changes. Best used for static groups of elements.
+             * @note The layer is the size of the container, so children outside of it are cut off.
+             * Children are drawn into the layer without blending (as in a Scrollable).
+             * The layer is bypassed while anything inside is animating or highlighted.
+             *
+             * @param b true to cache, false otherwise
+             */
+            void setCached(bool b);
+
             void addElement(Element * e);
             bool handleEvent(InputEvent * e);
             void removeAllElements();
+            void render();
 
             /**
-             * @brief Determine which element to move to
-             *
-             * @param parent parent element (usually this)
-             * @param check function which returns true if size between elements is valid
-             * @param dist function to return distance between two elements
-             * @return true if valid element found to move to
-             * @return false otherwise
+             * @brief Destroy the Container object (and cached layer)
              */
-            friend bool moveHighlight(Container * parent, std::function<bool(Element *, Element*)> check, std::function<int(Element *, Element *)> dist);
+            ~Container();
     };
 };
 
@@ -2,27 +2,37 @@
 #define AETHER_ELEMENT_HPP
 
 #include "Aether/InputEvent.hpp"
+#include "Aether/utils/ElementArena.hpp"
 #include <vector>
 
 namespace Aether {
     /**
      * @brief Element is the base class to be inherited
      * to form all other types of elements
+     *
+     * Co-ordinates passed to and returned from an element are always absolute
+     * (screen) positions, however they are stored relative to the parent. This
+     * means moving an element (or scrolling its children) is a constant time
+     * operation, as children simply follow their parent's position. Absolute
+     * positions are cached until anything moves, so reading them (every frame
+     * while rendering and hit-testing) doesn't walk up the tree each time.
+     *
+     * Elements created while an ElementArena is active are placed in that arena.
      */
     class Element {
         private:
-            /** @brief Horizontal position of element */
+            /** @brief Horizontal position of element (relative to parent's origin) */
             int x_;
-            /** @brief Vertical position of element */
+            /** @brief Vertical position of element (relative to parent's origin) */
             int y_;
             /** @brief Width of element */
             int w_;
             /** @brief Height of element */
             int h_;
-            /** @brief Indicator on whether the element should be rendered or not */
-            bool hidden_;
             /** @brief Function to call when the element is activated */
             std::function<void()> callback_;
+            /** @brief Indicator on whether the element should be rendered or not */
+            bool hidden_;
             /** @brief Indicator on whether element contains highlighted children element */
             bool hasHighlighted_;
             /** @brief Indicator on whether element contains selectable children element */
@@ -37,6 +47,45 @@ namespace Aether {
             bool selected_;
             /** @brief Indicator on whether element is touch responsive */
             bool touchable_;
+            /** @brief Horizontal offset applied to all children (e.g. scrolling) */
+            int childOffsetX_;
+            /** @brief Vertical offset applied to all children (e.g. scrolling) */
+            int childOffsetY_;
+            /** @brief Indicator on whether this element or a descendant needs laying out */
+            bool layoutPending_;
+            /** @brief Cached absolute x-coordinate (valid while absGeneration_ matches moveGeneration) */
+            int absX_;
+            /** @brief Cached absolute y-coordinate (valid while absGeneration_ matches moveGeneration) */
+            int absY_;
+            /** @brief Value of moveGeneration when the absolute position was cached */
+            uint64_t absGeneration_;
+
+            /** @brief Incremented whenever any element moves (or offsets its children), invalidating every cached position */
+            static uint64_t moveGeneration;
+
+            /**
+             * @brief Recalculates the cached absolute position if anything has moved since it was cached
+             */
+            void updatePosition();
+
+            /**
+             * @brief Marks every cached absolute position as out of date
+             */
+            static void positionsChanged();
+
+            /**
+             * @brief Returns the absolute x-coordinate that this element's position is relative to
+             *
+             * @return int parent's child origin (0 if no parent)
+             */
+            int originX();
+
+            /**
+             * @brief Returns the absolute y-coordinate that this element's position is relative to
+             *
+             * @return int parent's child origin (0 if no parent)
+             */
+            int originY();
 
         protected:
             /** @brief Background color if element is highlighted */
@@ -65,7 +114,80 @@ namespace Aether {
              */
              void addElementAt(Element * e, size_t i);
 
+            /**
+             * @brief Set the offset applied to the position of all children.
+             * @note This does not touch the children, so it is cheap to call every frame
+             *
+             * @param x horizontal offset
+             * @param y vertical offset
+             */
+            void setChildOffset(int x, int y);
+
+            /**
+             * @brief Returns the absolute x-coordinate that children are positioned relative to
+             *
+             * @return int x-coordinate of element plus child offset
+             */
+            int childOriginX();
+
+            /**
+             * @brief Returns the absolute y-coordinate that children are positioned relative to
+             *
+             * @return int y-coordinate of element plus child offset
+             */
+            int childOriginY();
+
+            /**
+             * @brief Called when a child element has been moved or resized
+             *
+             * @param e child that changed
+             */
+            virtual void childChanged(Element * e);
+
+            /**
+             * @brief Called when a child element is being deleted
+             * @note Not called for children deleted while this element is being destroyed
+             *
+             * @param e child being deleted
+             */
+            virtual void childRemoved(Element * e);
+
+            /**
+             * @brief Called when the element's appearance has changed, so that any
+             * cached layer containing it is redrawn (passed up to all ancestors)
+             */
+            virtual void invalidate();
+
+            /**
+             * @brief Marks this element (and all ancestors) as needing layout, so
+             * that the next call to layout() only walks down to it
+             */
+            void requestLayout();
+
+            /**
+             * @brief Returns whether this element or a descendant needs laying out
+             *
+             * @return true if layout is needed
+             * @return false otherwise
+             */
+            bool layoutPending();
+
         public:
+            /**
+             * @brief Allocate an element (from the active arena if there is one)
+             *
+             * @param n size of element
+             * @return pointer to memory for element
+             */
+            static void * operator new(size_t n);
+
+            /**
+             * @brief Free an element's memory (or release it back to its arena)
+             *
+             * @param p pointer to element's memory
+             */
+            static void operator delete(void * p);
+
             /**
              * @brief Construct a new Element object.
              *
@@ -82,14 +204,14 @@ namespace Aether {
             Element(int x = 0, int y = 0, int w = 100, int h = 100);
 
             /**
-             * @brief Returns x-coordinate of element
+             * @brief Returns (absolute) x-coordinate of element
              *
              * @return int x-coordinate of element
              */
             int x();
 
             /**
-             * @brief Returns y-coordinate of element
+             * @brief Returns (absolute) y-coordinate of element
              *
              * @return int y-coordinate of element
              */
@@ -110,14 +232,16 @@ namespace Aether {
             int h();
 
             /**
-             * @brief Set x-coordinate of element
+             * @brief Set (absolute) x-coordinate of element
+             * @note Children are not visited as they are positioned relative to this element
              *
              * @param x new x-coordinate of element
              */
             virtual void setX(int x);
 
             /**
-             * @brief Set y-coordinate of element
+             * @brief Set (absolute) y-coordinate of element
+             * @note Children are not visited as they are positioned relative to this element
              *
              * @param y new y-coordinate of element
              */
@@ -172,6 +296,7 @@ namespace Aether {
 
             /**
              * @brief Set the parent element of this element
+             * @note The element's absolute position is preserved
              *
              * @param p parent element to set as
              */
@@ -373,7 +498,7 @@ namespace Aether {
              *
              * @return callback function
              */
-            std::function<void()> callback();
+            const std::function<void()> & callback();
 
             /**
              * @brief Set callback function (also marks element as selectable)
@@ -398,6 +523,22 @@ namespace Aether {
              */
             virtual void update(uint32_t dt);
 
+            /**
+             * @brief Returns whether the element (or any visible child) will change on the
+             * next update without any input, i.e. whether the display needs to keep drawing frames
+             *
+             * @return true if animating
+             * @return false if the element is static
+             */
+            virtual bool isAnimating();
+
+            /**
+             * @brief Arrange children if required. By default this is only passed on to
+             * children which requested it, elements which position their children (e.g. stacks)
+             * override it.
+             */
+            virtual void layout();
+
             /**
              * @brief Render child elements
              */
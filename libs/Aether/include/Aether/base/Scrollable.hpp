@@ -10,6 +10,8 @@ namespace Aether {
      * to be 'cut off' outside the dimensions of the scrollable object.
      * Note that added elements will have their width changed to match the list!
      * Also note that elements are placed directly below the previous element (in terms of y-coords)!
+     * When adding/removing many elements wrap the changes in beginUpdate()/endUpdate()
+     * so the layout is only recalculated once.
      */
     class Scrollable : public Container {
         private:
@@ -23,6 +25,15 @@ namespace Aether {
             Colour scrollBarColour;
             /** @brief Whether to show the scroll bar */
             bool showScrollBar_;
+            /** @brief Number of unmatched beginUpdate() calls */
+            unsigned int updateDepth;
+            /** @brief Whether children have changed since beginUpdate() */
+            bool layoutDirty;
+
+            /**
+             * @brief Positions all children one after another (below the top padding)
+             */
+            void positionChildren();
 
             /**
              * @brief Returns amount of padding for one side based on padding type
@@ -161,6 +172,19 @@ namespace Aether {
              */
             void setScrollPos(int pos);
 
+            /**
+             * @brief Start a batch of changes. Until the matching endUpdate() call, adding and
+             * removing elements does not reposition the other children or recalculate the scroll limit.
+             * @note Calls can be nested; the layout happens on the outermost endUpdate()
+             * @note Touches and navigation only find added or moved children after endUpdate()
+             */
+            void beginUpdate();
+
+            /**
+             * @brief End a batch of changes, performing a single layout and scroll limit pass
+             */
+            void endUpdate();
+
             /**
              * @brief Add the given element to the list
              * @note The element's width will be set to match the width of the scrollable object
@@ -223,6 +247,7 @@ namespace Aether {
 
             bool handleEvent(InputEvent * e);
             void update(uint32_t dt);
+            bool isAnimating();
             void render();
 
             /**
@@ -0,0 +1,213 @@
+#ifndef AETHER_STACK_HPP
+#define AETHER_STACK_HPP
+
+#include "Aether/base/Container.hpp"
+#include <unordered_map>
+
+namespace Aether {
+    /**
+     * @brief A stack is a container which places it's children one after another,
+     * either horizontally or vertically, with optional padding and gaps between them.
+     *
+     * Children can be given a grow factor, in which case they share any space left
+     * over in the stack (in proportion to their factors). A stack can also size itself
+     * to fit it's children, allowing stacks to be nested.
+     *
+     * Layout is only recalculated when a child is resized, added or removed (or the stack
+     * itself is resized), and is done lazily before the next update/render.
+     * @note Children's positions are overwritten by the stack, so there's no need to set them.
+     * Hidden children still take up space.
+     */
+    class Stack : public Container {
+        private:
+            /** @brief Direction children are placed in */
+            Direction direction_;
+            /** @brief Alignment of children across the stack */
+            Align align_;
+            /** @brief Space around the edge of the stack (in pixels) */
+            int padding_;
+            /** @brief Space between each child (in pixels) */
+            int gap_;
+            /** @brief Whether the stack resizes itself to fit children */
+            bool fitContent_;
+            /** @brief Grow factor for each child (children not present don't grow) */
+            std::unordered_map<Element *, unsigned int> grow_;
+            /** @brief Size along the stack of a growing child */
+            struct Base {
+                /** @brief Size before growing */
+                int size;
+                /** @brief Size last given by the stack */
+                int grown;
+            };
+            /** @brief Base size of each growing child */
+            std::unordered_map<Element *, Base> base_;
+            /** @brief Whether layout needs to be recalculated */
+            bool dirty;
+            /** @brief Set while positioning children (so the changes don't mark the stack as dirty) */
+            bool laying;
+
+            /**
+             * @brief Position (and grow) all children
+             */
+            void arrange();
+
+            /**
+             * @brief Marks the layout as needing to be recalculated
+             */
+            void markDirty();
+
+            /**
+             * @brief Returns the size of a child along the stack
+             *
+             * @param e child to measure
+             * @return width or height depending on direction
+             */
+            int mainSize(Element * e);
+
+            /**
+             * @brief Set the size of a child along the stack (without marking the stack as dirty)
+             *
+             * @param e child to resize
+             * @param s new width or height depending on direction
+             */
+            void setMainSize(Element * e, int s);
+
+            /**
+             * @brief Returns all growing children to their base size
+             */
+            void resetBases();
+
+        protected:
+            void addElementAt(Element * e, size_t i);
+            void childChanged(Element * e);
+            void childRemoved(Element * e);
+
+        public:
+            /**
+             * @brief Construct a new Stack object
+             *
+             * @param x x-coordinate of stack
+             * @param y y-coordinate of stack
+             * @param w width of stack
+             * @param h height of stack
+             * @param d direction to place children in
+             */
+            Stack(int x = 0, int y = 0, int w = 100, int h = 100, Direction d = Direction::Vertical);
+
+            /**
+             * @brief Returns the direction children are placed in
+             *
+             * @return direction of stack
+             */
+            Direction direction();
+
+            /**
+             * @brief Set the direction children are placed in
+             *
+             * @param d new direction
+             */
+            void setDirection(Direction d);
+
+            /**
+             * @brief Returns the alignment of children across the stack
+             *
+             * @return alignment of children
+             */
+            Align align();
+
+            /**
+             * @brief Set the alignment of children across the stack
+             *
+             * @param a new alignment
+             */
+            void setAlign(Align a);
+
+            /**
+             * @brief Returns the space around the edge of the stack
+             *
+             * @return padding in pixels
+             */
+            int padding();
+
+            /**
+             * @brief Set the space around the edge of the stack
+             *
+             * @param p new padding in pixels
+             */
+            void setPadding(int p);
+
+            /**
+             * @brief Returns the space between children
+             *
+             * @return gap in pixels
+             */
+            int gap();
+
+            /**
+             * @brief Set the space between children
+             *
+             * @param g new gap in pixels
+             */
+            void setGap(int g);
+
+            /**
+             * @brief Returns whether the stack sizes itself to fit it's children
+             *
+             * @return true if sized to fit
+             * @return false otherwise
+             */
+            bool fitContent();
+
+            /**
+             * @brief Set whether the stack sizes itself to fit it's children
+             * @note Grow factors are ignored when sizing to fit
+             *
+             * @param b true to size to fit, false otherwise
+             */
+            void setFitContent(bool b);
+
+            /**
+             * @brief Returns the grow factor of a child
+             *
+             * @param e child to get factor of
+             * @return grow factor (0 if the child doesn't grow)
+             */
+            unsigned int grow(Element * e);
+
+            /**
+             * @brief Set the grow factor of a child. Children with a non-zero factor share
+             * the left over space in proportion to their factors
+             *
+             * @param e child to set factor of
+             * @param g new grow factor (0 to not grow)
+             */
+            void setGrow(Element * e, unsigned int g);
+
+            /**
+             * @brief Add an element to the end of the stack with the given grow factor
+             *
+             * @param e element to add
+             * @param g grow factor
+             */
+            void addElement(Element * e, unsigned int g);
+
+            /**
+             * @brief Add an element to the end of the stack (it doesn't grow)
+             *
+             * @param e element to add
+             */
+            void addElement(Element * e);
+
+            /**
+             * @brief Lay out children of the stack (and nested stacks) now if anything has changed
+             */
+            void layout();
+
+            void setW(int w);
+            void setH(int h);
+            void update(uint32_t dt);
+            void render();
+    };
+};
+
+#endif
@@ -178,6 +178,11 @@ namespace Aether {
              */
             void update(uint32_t);
 
+            /**
+             * @brief Also animating while the texture is being generated (so it is shown once ready)
+             */
+            bool isAnimating();
+
             /**
              * @brief Render the texture
              */
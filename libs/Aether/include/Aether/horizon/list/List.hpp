@@ -16,6 +16,8 @@ namespace Aether {
             bool scroll;
             /** @brief Whether to wrap around */
             bool wrapAround_;
+            /** @brief Whether the last update moved the list (held scroll or catching up to focus) */
+            bool moving;
 
         public:
             /**
@@ -59,6 +61,14 @@ namespace Aether {
              * @param dt change in time
              */
             void update(uint32_t dt);
+
+            /**
+             * @brief Also animating while the list is moving to the focused element
+             *
+             * @return true if animating
+             * @return false otherwise
+             */
+            bool isAnimating();
     };
 };
 
@@ -0,0 +1,173 @@
+#ifndef AETHER_VIRTUALLIST_HPP
+#define AETHER_VIRTUALLIST_HPP
+
+#include "Aether/base/Element.hpp"
+#include "Aether/primary/Text.hpp"
+#include <functional>
+
+namespace Aether {
+    /**
+     * @brief A VirtualList shows rows of single-line text from a function instead of
+     * holding an element per row, so it can show any number of rows (e.g. a
+     * disassembly listing). Only the visible rows exist and only rows which
+     * scroll into view are rendered again. It scrolls a whole row at a time.
+     */
+    class VirtualList : public Element {
+        private:
+            /** @brief Function returning the text for a row */
+            std::function<std::string(size_t)> rowFunc;
+            /** @brief Number of rows */
+            size_t rows_;
+            /** @brief Index of the first visible row */
+            size_t topRow_;
+            /** @brief Height of each row in pixels */
+            unsigned int rowHeight_;
+            /** @brief Font size of row text */
+            unsigned int fontSize_;
+            /** @brief Colour of row text */
+            Colour textColour;
+
+            /** @brief Text elements for the visible rows, row r is always shown by slots[r % slots.size()] */
+            std::vector<Text *> slots;
+            /** @brief Row each slot currently holds the text for (rows_ if none) */
+            std::vector<size_t> slotRows;
+            /** @brief Arena the slots are allocated from, reused each time they are recreated */
+            ElementArena slotArena;
+
+            /** @brief Button that is being currently held, if any */
+            Button heldButton;
+            /** @brief Time the button has been held for (in ms) */
+            int holdTime;
+            /** @brief Indicator on whether the list is being touched */
+            bool isTouched;
+            /** @brief Vertical position the current drag is measured from */
+            int touchY;
+
+            /**
+             * @brief Creates a text element for each row that fits
+             */
+            void createSlots();
+
+            /**
+             * @brief Assigns and positions the slots for the visible rows, only
+             * re-rendering slots which now show a different row
+             */
+            void updateSlots();
+
+            /**
+             * @brief Get the number of rows a D-Pad button scrolls by
+             *
+             * @param b button pressed
+             * @return rows to move by (negative moves up), 0 if the button doesn't scroll
+             */
+            long buttonRows(Button b);
+
+            /**
+             * @brief Moves the visible rows by the given amount (clamped)
+             *
+             * @param d number of rows to move by (negative moves up)
+             * @return true if the list moved
+             * @return false otherwise
+             */
+            bool moveRows(long d);
+
+        public:
+            /**
+             * @brief Construct a new Virtual List object
+             *
+             * @param x x-coordinate of start position offset
+             * @param y y-coordinate of start position offset
+             * @param w width of list
+             * @param h height of list
+             * @param r height of each row
+             * @param f font size of row text
+             */
+            VirtualList(int x, int y, int w, int h, unsigned int r, unsigned int f);
+
+            /**
+             * @brief Set the rows to show, the list returns to the top
+             *
+             * @param n number of rows
+             * @param f function returning the text for a row (only called for visible rows)
+             */
+            void setRows(size_t n, std::function<std::string(size_t)> f);
+
+            /**
+             * @brief Get the number of rows
+             *
+             * @return number of rows
+             */
+            size_t rows();
+
+            /**
+             * @brief Get the index of the first visible row
+             *
+             * @return index of the first visible row
+             */
+            size_t topRow();
+
+            /**
+             * @brief Scroll so the given row is the first visible one (or as close as possible)
+             *
+             * @param r index of row
+             */
+            void setTopRow(size_t r);
+
+            /**
+             * @brief Get the number of rows that fit in the list
+             *
+             * @return number of visible rows
+             */
+            size_t visibleRows();
+
+            /**
+             * @brief Asks for the text of every visible row again (call when the underlying data changes)
+             */
+            void refresh();
+
+            /**
+             * @brief Set the colour of row text
+             *
+             * @param c new colour
+             */
+            void setTextColour(Colour c);
+
+            /**
+             * @brief Set the height of the list, more or less rows are shown
+             *
+             * @param h new height
+             */
+            void setH(int h);
+
+            /**
+             * @brief Handles scrolling with the D-Pad (up/down by a row, left/right by a page) and touch
+             *
+             * @param e event to attempt handle
+             * @return true if event was handled
+             * @return false otherwise
+             */
+            bool handleEvent(InputEvent * e);
+
+            /**
+             * @brief Repeats scrolling while a button is held
+             *
+             * @param dt change in time
+             */
+            void update(uint32_t dt);
+
+            /**
+             * @brief Also animating while a button is held or the list is touched
+             *
+             * @return true if animating
+             * @return false otherwise
+             */
+            bool isAnimating();
+
+            /**
+             * @brief Destroy the Virtual List object (deleting the slots before their arena)
+             */
+            ~VirtualList();
+    };
+};
+
+#endif
\ No newline at end of file
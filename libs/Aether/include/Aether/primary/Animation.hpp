@@ -41,6 +41,11 @@ namespace Aether {
              */
             void update(uint32_t dt);
 
+            /**
+             * @brief Animating while not paused and there is more than one frame
+             */
+            bool isAnimating();
+
             /**
              * @brief All children aren't rendered - only the current one
              */
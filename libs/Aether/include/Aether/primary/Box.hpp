@@ -6,7 +6,10 @@
 namespace Aether {
     /**
      * @brief A Box is a rectangle outline with no fill.
-     * @note This element can not have the texture generation deferred yet!
+     * It doesn't own a texture - it is drawn at any size from small textures
+     * shared between all boxes with the same border/radius (see \ref SDLHelper::drawSlicedRect),
+     * so resizing it is free.
+     * @note Masks have no effect and texW()/texH() are always 0.
      */
     class Box : public Texture {
         private:
@@ -16,7 +19,7 @@ namespace Aether {
             /** @brief Radius of each corner (draws rounded rectangle when > 0) */
             unsigned int cornerRadius_;
 
-            /** @brief Generate a box surface */
+            /** @brief Does nothing (box is drawn directly) */
             void generateSurface();
 
         public:
@@ -66,6 +69,11 @@ namespace Aether {
              * @param h new height of box
              */
             void setBoxSize(int w, int h);
+
+            /**
+             * @brief Render the box
+             */
+            void render();
     };
 };
 
@@ -5,9 +5,12 @@
 
 namespace Aether {
     /**
-     * @brief An ellipse is a texture containing an ellipse.
+     * @brief An ellipse is an element drawn as a filled ellipse.
      * It can be used as both a circle and ellipse/oval.
-     * @note This element can not have the texture generation deferred yet!
+     * It doesn't own a texture - it is drawn from a cached triangle mesh
+     * (see \ref SDLHelper::drawEllipse), so resizing it is free.
+     * @note The element is 4 pixels larger than the diameters (as the texture used to be).
+     * Masks have no effect and texW()/texH() are always 0.
      */
     class Ellipse : public Texture {
         private:
@@ -16,7 +19,7 @@ namespace Aether {
             /** @brief Vertical diameter */
             unsigned int yDiameter_;
 
-            /** @brief Generate an ellipse surface */
+            /** @brief Does nothing (ellipse is drawn directly) */
             void generateSurface();
 
         public:
@@ -68,6 +71,11 @@ namespace Aether {
              * @brief Draw elliptical selected instead of rectangle
              */
             void renderSelected();
+
+            /**
+             * @brief Render the ellipse
+             */
+            void render();
     };
 };
 
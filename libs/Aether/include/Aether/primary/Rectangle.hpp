@@ -5,18 +5,18 @@
 
 namespace Aether {
     /**
-     * @brief A rectangle is a texture containing either a normal or
-     * rounded rectangle. The object stores all relevant information
-     * so that it can be regenerated whenever the dimensions/radius
-     * changes.
-     * @note This element can not have the texture generation deferred yet!
+     * @brief A rectangle is an element drawn as either a normal or
+     * rounded rectangle. It doesn't own a texture - rounded corners come
+     * from small textures shared between all rectangles with the same radius
+     * (see \ref SDLHelper::drawSlicedRect), so resizing it is free.
+     * @note Masks have no effect and texW()/texH() are always 0.
      */
     class Rectangle : public Texture {
         private:
             /** @brief Radius of each corner (draws rounded rectangle when > 0) */
             unsigned int cornerRadius_;
 
-            /** @brief Generate a rectangle surface */
+            /** @brief Does nothing (rectangle is drawn directly) */
             void generateSurface();
 
         public:
@@ -52,6 +52,11 @@ namespace Aether {
              * @param h new height of rectangle
              */
             void setRectSize(int w, int h);
+
+            /**
+             * @brief Render the rectangle
+             */
+            void render();
     };
 };
 
@@ -0,0 +1,143 @@
+#ifndef AETHER_SPRITEANIMATION_HPP
+#define AETHER_SPRITEANIMATION_HPP
+
+#include "Aether/primary/Image.hpp"
+#include <vector>
+
+namespace Aether {
+    /**
+     * @brief A sprite animation is an image containing every frame of an animation (a sprite
+     * sheet/atlas). Only one texture is created and each frame is drawn from a region of it,
+     * unlike \ref Animation which requires an element (and texture) per frame.
+     *
+     * By default frames are sliced from the sheet in a grid (left to right, top to bottom),
+     * but the regions can also be set explicitly.
+     * @note The element is sized to the first frame once the sheet has been loaded.
+     */
+    class SpriteAnimation : public Image {
+        private:
+            /** @brief Width of each frame when sliced as a grid */
+            int frameW;
+            /** @brief Height of each frame when sliced as a grid */
+            int frameH;
+            /** @brief Maximum number of frames to slice (0 for all that fit) */
+            unsigned int maxFrames;
+            /** @brief Whether the regions were set explicitly (and shouldn't be sliced) */
+            bool customFrames;
+            /** @brief Region of the sheet for each frame */
+            std::vector<SDL_Rect> frames;
+
+            /** @brief Index of currently shown frame */
+            unsigned int idx;
+            /** @brief Time each frame should be shown for in milliseconds */
+            int frameTime;
+            /** @brief Time spent on current frame in milliseconds */
+            int currTime;
+            /** @brief Pauses animation when set true */
+            bool paused;
+
+            /** @brief Slice the sheet into frames (if not set explicitly) */
+            void sliceSheet();
+
+            /** @brief Set size and mask to show the current frame */
+            void showFrame();
+
+        public:
+            /**
+             * @brief Construct a new Sprite Animation object
+             *
+             * @param x x-coordinate of start position offset
+             * @param y y-coordinate of start position offset
+             * @param p path to sprite sheet
+             * @param fw width of each frame
+             * @param fh height of each frame
+             * @param n number of frames (0 for as many as fit in the sheet)
+             * @param t \ref ::RenderType to use for sheet generation
+             */
+            SpriteAnimation(int x, int y, std::string p, int fw, int fh, unsigned int n = 0, RenderType t = RenderType::OnCreate);
+
+            /**
+             * @brief Construct a new Sprite Animation object
+             *
+             * @param x x-coordinate of start position offset
+             * @param y y-coordinate of start position offset
+             * @param p pointer to sprite sheet data start
+             * @param s sprite sheet data size
+             * @param fw width of each frame
+             * @param fh height of each frame
+             * @param n number of frames (0 for as many as fit in the sheet)
+             * @param t \ref ::RenderType to use for sheet generation
+             */
+            SpriteAnimation(int x, int y, u8 * p, size_t s, int fw, int fh, unsigned int n = 0, RenderType t = RenderType::OnCreate);
+
+            /**
+             * @brief Set the region of the sheet used for each frame (instead of slicing it as a grid)
+             *
+             * @param f vector of regions, in the order they are shown
+             */
+            void setFrames(std::vector<SDL_Rect> f);
+
+            /**
+             * @brief Returns the number of frames
+             * @note This is 0 until the sheet has been loaded (unless set explicitly)
+             *
+             * @return number of frames
+             */
+            unsigned int frameCount();
+
+            /**
+             * @brief Updates handles switching between frames
+             *
+             * @param dt change in time
+             */
+            void update(uint32_t dt);
+
+            /**
+             * @brief Animating while not paused and there is more than one frame
+             */
+            bool isAnimating();
+
+            /**
+             * @brief Pause the animation
+             */
+            void pause();
+
+            /**
+             * @brief Resume the animation
+             */
+            void resume();
+
+            /**
+             * @brief Check if animation is paused
+             *
+             * @return true if animation is paused
+             * @return false otherwise
+             */
+            bool isPaused();
+
+            /**
+             * @brief Set time for each frame
+             *
+             * @param t time for each frame
+             */
+            void setAnimateSpeed(int t);
+
+            /**
+             * @brief Returns animation time
+             *
+             * @return animation time
+             */
+            unsigned int animateSpeed();
+
+            /**
+             * @brief Set current frame to frame at given index
+             *
+             * @param i frame index
+             * @return true if within range
+             * @return false otherwise
+             */
+            bool setFrameIndex(unsigned int i);
+    };
+};
+
+#endif
@@ -0,0 +1,192 @@
+#ifndef AETHER_STREAMANIMATION_HPP
+#define AETHER_STREAMANIMATION_HPP
+
+#include "Aether/base/Element.hpp"
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Aether {
+    /**
+     * @brief A stream animation is an animation whose frames are decoded on demand,
+     * for animations too long to keep every frame in memory. Frames are decoded on
+     * another thread a few ahead of the one being shown, and uploaded into a small
+     * ring of textures which are reused for the whole animation.
+     *
+     * If the next frame isn't ready in time the current one is kept on screen
+     * (the animation slows down rather than flickering).
+     * @note The decode function is called on another thread! It must return an RGBA32
+     * surface (e.g. from \ref SDLHelper::renderImageS) and every frame must be the same size.
+     */
+    class StreamAnimation : public Element {
+        public:
+            /** @brief Function which decodes the frame with the given index */
+            typedef std::function<SDL_Surface * (unsigned int)> DecodeFunc;
+
+        private:
+            /**
+             * @brief Enum class for status of a slot in the ring
+             */
+            enum class SlotStatus {
+                Empty,      /**< Nothing stored */
+                Decoding,   /**< Frame is being decoded */
+                Decoded,    /**< Surface is ready to be uploaded */
+                Ready,      /**< Texture holds the frame */
+                Failed      /**< Frame couldn't be decoded (it is skipped) */
+            };
+
+            /**
+             * @brief Struct storing a single texture in the ring
+             */
+            struct Slot {
+                unsigned int step;      /**< Playback step stored (frame is step % number of frames) */
+                SlotStatus status;      /**< Status of slot */
+                SDL_Surface * surface;  /**< Decoded surface waiting to be uploaded */
+                SDL_Texture * texture;  /**< Texture (kept for reuse) */
+            };
+
+            /**
+             * @brief State shared with decode tasks (so they can finish after the element is deleted)
+             */
+            struct Shared {
+                std::mutex mutex;           /**< Protects slots and cancelled */
+                std::vector<Slot> slots;    /**< Ring of slots */
+                DecodeFunc decode;          /**< Function to decode a frame */
+                bool cancelled;             /**< Set when the element is deleted */
+            };
+
+            /** @brief State shared with decode tasks */
+            std::shared_ptr<Shared> shared;
+            /** @brief Number of frames in the animation */
+            unsigned int frames;
+            /** @brief Current playback step (increases forever, frame shown is step % frames) */
+            unsigned int step;
+            /** @brief Time each frame should be shown for in milliseconds */
+            int frameTime;
+            /** @brief Time spent on current frame in milliseconds */
+            int currTime;
+            /** @brief Pauses animation when set true */
+            bool paused;
+
+            /**
+             * @brief Queue decoding of a step into it's slot
+             *
+             * @param s step to decode
+             */
+            void queueStep(unsigned int s);
+
+            /**
+             * @brief Upload decoded frames and queue the ones needed next
+             * @note Must be called with the mutex locked
+             */
+            void fillRing();
+
+        public:
+            /**
+             * @brief Construct a new Stream Animation object
+             *
+             * @param x x-coordinate of start position offset
+             * @param y y-coordinate of start position offset
+             * @param w width of animation (frames are scaled to fit)
+             * @param h height of animation (frames are scaled to fit)
+             * @param n number of frames
+             * @param f function to decode a frame (called on another thread)
+             * @param r number of textures in the ring (minimum of 2)
+             */
+            StreamAnimation(int x, int y, int w, int h, unsigned int n, DecodeFunc f, unsigned int r = 3);
+
+            /**
+             * @brief Construct a new Stream Animation object from a list of image files
+             *
+             * @param x x-coordinate of start position offset
+             * @param y y-coordinate of start position offset
+             * @param w width of animation (frames are scaled to fit)
+             * @param h height of animation (frames are scaled to fit)
+             * @param p paths to each frame's image, in order
+             * @param r number of textures in the ring (minimum of 2)
+             */
+            StreamAnimation(int x, int y, int w, int h, std::vector<std::string> p, unsigned int r = 3);
+
+            /**
+             * @brief Returns the number of frames
+             *
+             * @return number of frames
+             */
+            unsigned int frameCount();
+
+            /**
+             * @brief Returns the index of the frame being shown
+             *
+             * @return frame index
+             */
+            unsigned int frameIndex();
+
+            /**
+             * @brief Updates handles uploading frames and switching between them
+             *
+             * @param dt change in time
+             */
+            void update(uint32_t dt);
+
+            /**
+             * @brief Animating while not paused and there is more than one frame,
+             * or a frame is still being decoded
+             */
+            bool isAnimating();
+
+            /**
+             * @brief Render the current frame
+             */
+            void render();
+
+            /**
+             * @brief Pause the animation
+             */
+            void pause();
+
+            /**
+             * @brief Resume the animation
+             */
+            void resume();
+
+            /**
+             * @brief Check if animation is paused
+             *
+             * @return true if animation is paused
+             * @return false otherwise
+             */
+            bool isPaused();
+
+            /**
+             * @brief Set time for each frame
+             *
+             * @param t time for each frame
+             */
+            void setAnimateSpeed(int t);
+
+            /**
+             * @brief Returns animation time
+             *
+             * @return animation time
+             */
+            unsigned int animateSpeed();
+
+            /**
+             * @brief Jump to the frame at the given index (it's shown once decoded)
+             *
+             * @param i frame index
+             * @return true if within range
+             * @return false otherwise
+             */
+            bool setFrameIndex(unsigned int i);
+
+            /**
+             * @brief Destroy the Stream Animation object (and ring of textures)
+             * @note Frames still being decoded are freed when they finish
+             */
+            ~StreamAnimation();
+    };
+};
+
+#endif
@@ -21,6 +21,9 @@ namespace Aether {
             /** @brief Generate a text surface */
             void generateSurface();
 
+            /** @brief Size the element using font metrics while there is no texture (so it can be laid out) */
+            void measure();
+
         public:
             /**
              * @brief Construct a new Text object
@@ -85,6 +88,11 @@ namespace Aether {
              */
             void update(uint32_t dt);
 
+            /**
+             * @brief Scrolling text is always animating
+             */
+            bool isAnimating();
+
             /**
              * @brief Adjusts the text width.
              *
@@ -0,0 +1,122 @@
+#ifndef AETHER_ELEMENTARENA_HPP
+#define AETHER_ELEMENTARENA_HPP
+
+#include <cstddef>
+#include <vector>
+
+namespace Aether {
+    /**
+     * @brief An optional bump allocator for element trees.
+     *
+     * While an arena is active (between begin() and end()) every element created
+     * with new is placed inside the arena's blocks instead of being a separate heap
+     * allocation. Elements are still deleted as usual (so destructors run), however
+     * their memory is only reclaimed in one go once every element in the arena has
+     * been deleted, at which point the blocks are reused for the next rebuild.
+     *
+     * @note All elements allocated from an arena must be deleted before the arena is.
+     * @note An arena is only active on the thread which called begin(), elements
+     * created on other threads (e.g. in runAsync()) still come from the heap.
+     */
+    class ElementArena {
+        private:
+            /** @brief Arena which new elements on this thread are allocated from (nullptr for the heap) */
+            static thread_local ElementArena * active_;
+
+            /** @brief Blocks of memory owned by the arena */
+            std::vector<char *> blocks;
+            /** @brief Allocations too large to fit in a block (freed on rewind) */
+            std::vector<char *> large;
+            /** @brief Size of each block (in bytes) */
+            size_t blockSize;
+            /** @brief Index of block currently being allocated from */
+            size_t block;
+            /** @brief Bytes used in the current block */
+            size_t used;
+            /** @brief Number of allocations which haven't been released */
+            size_t live;
+            /** @brief Arena which was active before begin() was called */
+            ElementArena * prev;
+
+            /**
+             * @brief Rewind to the start of the first block and free large allocations (called once nothing is live)
+             */
+            void rewind();
+
+        public:
+            /**
+             * @brief Makes an arena active for the lifetime of the object (e.g. while a screen is rebuilt)
+             */
+            class Scope {
+                private:
+                    /** @brief Arena which is active */
+                    ElementArena & arena;
+
+                public:
+                    /**
+                     * @brief Construct a new Scope object, calling begin() on the arena
+                     *
+                     * @param a arena to allocate new elements from
+                     */
+                    Scope(ElementArena & a);
+
+                    /**
+                     * @brief Destroy the Scope object, calling end() on the arena
+                     */
+                    ~Scope();
+            };
+
+            /**
+             * @brief Construct a new Element Arena object
+             *
+             * @param size size of each block to allocate (in bytes)
+             */
+            ElementArena(size_t size = 0);
+
+            /**
+             * @brief Make this arena the one new elements are allocated from (on the calling thread)
+             * @note Calls can be nested (with a different arena); end() restores the previous one
+             */
+            void begin();
+
+            /**
+             * @brief Stop allocating new elements from this arena
+             */
+            void end();
+
+            /**
+             * @brief Allocate memory from the arena
+             *
+             * @param n number of bytes required
+             * @return pointer to memory (aligned for any type), nullptr if out of memory
+             */
+            void * allocate(size_t n);
+
+            /**
+             * @brief Mark an allocation as released
+             * @note Memory is reclaimed once all allocations have been released
+             */
+            void release();
+
+            /**
+             * @brief Returns the number of allocations which haven't been released
+             *
+             * @return number of live allocations
+             */
+            size_t liveCount();
+
+            /**
+             * @brief Returns the arena which is currently active on the calling thread
+             *
+             * @return active arena or nullptr if elements are allocated on the heap
+             */
+            static ElementArena * active();
+
+            /**
+             * @brief Destroy the Element Arena object (freeing all blocks)
+             */
+            ~ElementArena();
+    };
+};
+
+#endif
@@ -36,13 +36,21 @@ namespace SDLHelper {
     int numTextures();
 
     /**
-     * @brief Initialize all required/used parts of SDL
+     * @brief Initialize all parts of SDL required to draw the first frame
      *
      * @return true if initialzation succeeded
      * @return false otherwise
      */
     bool initSDL();
 
+    /**
+     * @brief Initialize joystick support (done after the first frame as input can't be used before)
+     *
+     * @return true if initialzation succeeded
+     * @return false otherwise
+     */
+    bool initJoystick();
+
     /**
      * @brief Clean up all initialized parts of SDL
      */
@@ -73,6 +81,27 @@ namespace SDLHelper {
      */
     SDL_Texture * createTexture(int w, int h);
 
+    /**
+     * @brief Create a texture with given dimensions whose pixels can be replaced
+     * with \ref updateTexture (used to reuse textures for frames)
+     *
+     * @param w width of texture
+     * @param h height of texture
+     * @return created texture
+     */
+    SDL_Texture * createStreamingTexture(int w, int h);
+
+    /**
+     * @brief Copy a surface's pixels into a streaming texture and frees the surface
+     * @note Must be called in main thread! The surface must be RGBA32 and the same size as the texture.
+     *
+     * @param t texture to update
+     * @param s surface to copy from
+     * @return true if the texture was updated
+     * @return false otherwise
+     */
+    bool updateTexture(SDL_Texture * t, SDL_Surface * s);
+
     /**
      * @brief DestroyTexture wrapper
      *
@@ -136,6 +165,20 @@ namespace SDLHelper {
      */
     void renderToTexture(SDL_Texture * t);
 
+    /**
+     * @brief Returns the texture currently being rendered to
+     *
+     * @return render target (nullptr if rendering to the screen)
+     */
+    SDL_Texture * getRenderTarget();
+
+    /**
+     * @brief Set renderer to given texture without clearing it (used to go back to a previous target)
+     *
+     * @param t texture to render to (nullptr for the screen)
+     */
+    void setRenderTarget(SDL_Texture * t);
+
     /**
      * @brief Get the current texture blend mode
      *
@@ -224,6 +267,20 @@ namespace SDLHelper {
      */
     void drawRect(SDL_Color c, int x, int y, int w, int h, unsigned int b);
 
+    /**
+     * @brief Draw a (rounded) rectangle of any size using cached nine-slice textures.
+     * Corners are only rendered once per radius/border and the edges/centre are stretched.
+     *
+     * @param c colour to draw with
+     * @param x top left x coordinate
+     * @param y top left y coordinate
+     * @param w width
+     * @param h height
+     * @param r corner radius
+     * @param b border size (0 for a filled rectangle)
+     */
+    void drawSlicedRect(SDL_Color c, int x, int y, int w, int h, unsigned int r, unsigned int b = 0);
+
     /**
      * @brief Draw provided texture at specified coordinates tinted with given colour
      *
@@ -246,6 +303,8 @@ namespace SDLHelper {
     // -> The caller must destroy the surface/texture
 
     // -= SURFACES =-
+    // -> These don't use the renderer, so are safe to call on another thread
+
     /**
      * @brief Renders a filled corner rectangle
      *
@@ -265,6 +324,36 @@ namespace SDLHelper {
      */
     SDL_Surface * renderRectS(int w, int h, unsigned int b);
 
+    /**
+     * @brief Renders an (anti-aliased) ellipse centred within a surface 4 pixels larger than it
+     *
+     * @param xd x-diameter of ellipse
+     * @param yd y-diameter of ellipse
+     * @return pointer to rendered surface
+     */
+    SDL_Surface * renderEllipseS(unsigned int xd, unsigned int yd);
+
+    /**
+     * @brief Renders an (anti-aliased) filled rounded corner rectangle
+     *
+     * @param w width of rectangle
+     * @param h height of rectangle
+     * @param r corner radius
+     * @return pointer to rendered surface
+     */
+    SDL_Surface * renderFilledRoundRectS(int w, int h, unsigned int r);
+
+    /**
+     * @brief Renders an (anti-aliased) rounded corner rectangle outline
+     *
+     * @param w width of rectangle
+     * @param h height of rectangle
+     * @param r corner radius
+     * @param b border thickness
+     * @return pointer to rendered surface
+     */
+    SDL_Surface * renderRoundRectS(int w, int h, unsigned int r, unsigned int b);
+
     /**
      * @brief Renders image from image path
      * @note The scaling factors only shrink for the time being!
@@ -299,6 +388,18 @@ namespace SDLHelper {
      */
     SDL_Surface * renderTextS(std::string str, int font_size, int style = TTF_STYLE_NORMAL);
 
+    /**
+     * @brief Measures the size text will be rendered at using font metrics (without rendering it)
+     * @note The size may differ from the rendered surface by a pixel or so
+     *
+     * @param str text to measure
+     * @param font_size font size to measure with
+     * @param w pointer to write width to
+     * @param h pointer to write height to
+     * @param style font style to measure with
+     */
+    void getTextDimensions(std::string str, int font_size, int * w, int * h, int style = TTF_STYLE_NORMAL);
+
     /**
      * @brief Renders text with specified width
      *
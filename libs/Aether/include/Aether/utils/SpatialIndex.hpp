@@ -0,0 +1,145 @@
+#ifndef AETHER_SPATIALINDEX_HPP
+#define AETHER_SPATIALINDEX_HPP
+
+#include "Aether/utils/Types.hpp"
+#include <unordered_map>
+#include <vector>
+
+namespace Aether {
+    class Element;
+
+    /**
+     * @brief A uniform grid which buckets elements by the cells they overlap.
+     * It is used by containers to answer "what is under this point" and
+     * "what is the nearest element in this direction" without visiting
+     * every child.
+     * @note Rectangles are in whatever co-ordinate space the owner chooses,
+     * as long as it is consistent (containers use their children's origin).
+     */
+    class SpatialIndex {
+        private:
+            /**
+             * @brief Struct storing an element's rectangle and the cells it covers
+             */
+            struct Entry {
+                SDL_Rect rect;  /**< Rectangle of element */
+                int minCX;      /**< First column covered */
+                int minCY;      /**< First row covered */
+                int maxCX;      /**< Last column covered (inclusive) */
+                int maxCY;      /**< Last row covered (inclusive) */
+                uint64_t order; /**< Position of the element among the owner's elements (breaks ties) */
+            };
+
+            /** @brief Elements stored within each cell, keyed by packed cell co-ordinates */
+            std::unordered_map<uint64_t, std::vector<Element *> > cells;
+            /** @brief Stored entry for each element */
+            std::unordered_map<Element *, Entry> entries;
+            /** @brief Range of cells which have been occupied (bounds direction searches) */
+            int minCX, minCY, maxCX, maxCY;
+            /** @brief Order given to the next new element */
+            uint64_t nextOrder;
+
+            /**
+             * @brief Returns the cell containing the given co-ordinate
+             *
+             * @param v co-ordinate to convert
+             * @return cell index
+             */
+            static int cellOf(int v);
+
+            /**
+             * @brief Packs cell co-ordinates into a single key
+             *
+             * @param cx cell column
+             * @param cy cell row
+             * @return key for cells map
+             */
+            static uint64_t key(int cx, int cy);
+
+            /**
+             * @brief Adds element to all cells within the entry's range
+             *
+             * @param e element to add
+             * @param en entry describing covered cells
+             */
+            void addToCells(Element * e, const Entry & en);
+
+            /**
+             * @brief Removes element from all cells within the entry's range
+             *
+             * @param e element to remove
+             * @param en entry describing covered cells
+             */
+            void removeFromCells(Element * e, const Entry & en);
+
+        public:
+            /**
+             * @brief Construct a new (empty) Spatial Index object
+             */
+            SpatialIndex();
+
+            /**
+             * @brief Insert an element, or update it if already present
+             *
+             * @param e element to insert
+             * @param r rectangle occupied by element
+             */
+            void insert(Element * e, SDL_Rect r);
+
+            /**
+             * @brief Remove an element (does nothing if not present)
+             *
+             * @param e element to remove
+             */
+            void remove(Element * e);
+
+            /**
+             * @brief Remove all elements
+             */
+            void clear();
+
+            /**
+             * @brief Set the order of every indexed element to its position in the given list
+             * @note New elements are ordered after existing ones, so this is only
+             * needed when an element is inserted before others
+             *
+             * @param v elements in order (elements which aren't indexed are ignored)
+             */
+            void reorder(const std::vector<Element *> & v);
+
+            /**
+             * @brief Get the rectangle stored for an element
+             *
+             * @param e element to look up
+             * @param r pointer to write rectangle to
+             * @return true if element is indexed
+             * @return false otherwise
+             */
+            bool rect(Element * e, SDL_Rect * r);
+
+            /**
+             * @brief Find all elements whose rectangle contains the given point.
+             * Elements are appended in order (see reorder()).
+             *
+             * @param x x-coordinate of point
+             * @param y y-coordinate of point
+             * @param v vector to append elements to (not cleared)
+             */
+            void elementsAt(int x, int y, std::vector<Element *> & v);
+
+            /**
+             * @brief Find the nearest visible, selectable element in the given direction.
+             * Uses the same edge-to-edge distance as d-pad navigation always has,
+             * but only visits cells in expanding rings around the start point.
+             * Equally near elements resolve to the one first in order, which
+             * for a container is its first child.
+             *
+             * @param cur element to move from (must be indexed)
+             * @param b direction to move in (DPAD_*)
+             * @return nearest element or nullptr if none found
+             */
+            Element * nearest(Element * cur, Button b);
+    };
+};
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef AETHER_TRACE_HPP
+#define AETHER_TRACE_HPP
+
+#include <string>
+
+namespace Aether {
+    /**
+     * @brief A simple phase trace used to measure startup.
+     * Each mark records the time since the program started; the marks are
+     * written to a file once the first frame has been shown.
+     */
+    namespace Trace {
+        /**
+         * @brief Set the file to write the trace to (nothing is written if not set)
+         *
+         * @param path path of file to write
+         */
+        void setFile(std::string path);
+
+        /**
+         * @brief Record that a phase has finished
+         * @note It is safe to call this from any thread
+         *
+         * @param phase name of phase
+         */
+        void mark(std::string phase);
+
+        /**
+         * @brief Write all marks to the file (called internally after the first frame)
+         *
+         * @return true if written successfully
+         * @return false otherwise
+         */
+        bool flush();
+    };
+};
+
+#endif
@@ -50,6 +50,23 @@ namespace Aether {
         None           /**< No padding whatsoever (item width = list width) */
     };
 
+    /**
+     * @brief Enum class for the direction a stack arranges it's children in
+     */
+    enum class Direction {
+        Horizontal,         /**< Children are placed left to right */
+        Vertical            /**< Children are placed top to bottom */
+    };
+
+    /**
+     * @brief Enum class for alignment of children across a stack
+     */
+    enum class Align {
+        Start,              /**< Aligned to the top/left */
+        Centre,             /**< Centred */
+        End                 /**< Aligned to the bottom/right */
+    };
+
     /**
      * @brief Enum class for type of texture generation
      */
@@ -1,11 +1,18 @@
 #include "Aether/Display.hpp"
 #include "Aether/ThreadPool.hpp"
+#include "Aether/utils/Trace.hpp"
 #include "Aether/utils/Utils.hpp"
 
 // Delay (in ms) to pause after button held
 #define HOLD_DELAY 400
 // Delay (in ms) for moving between items
 #define MOVE_DELAY 100
+// Maximum time (in ms) to wait for input when idle
+#define IDLE_WAIT 1000
+// Time (in ms) to wait between frames when only the highlight border is animating
+#define HIGHLIGHT_WAIT 100
+// Time (in ms) after input that the highlight border keeps animating
+#define HIGHLIGHT_TIME 3000
 
 // Struct representing a "clock", which stores time between ticks
 struct Clock {
@@ -29,12 +36,14 @@ namespace Aether {
         this->setParent(nullptr);
 
         this->bgImg = nullptr;
+        this->screenSnapshot = nullptr;
         this->fadeAlpha = 0;
         this->fadeOut = false;
         this->fading = false;
         this->heldButton = Button::NO_BUTTON;
         this->heldTime = 0;
         this->holdDelay_ = MOVE_DELAY;
+        this->lastInput = 0;
 
         this->hiAnim = [](uint32_t t){
             return Colour{255, 255, 255, 255};
@@ -47,6 +56,8 @@ namespace Aether {
         // Initialize SDL (loop set to false if an error)
         this->loop_ = SDLHelper::initSDL();
         this->fps_ = false;
+        this->shownFrame = false;
+        Trace::mark("Display created");
     }
 
     void Display::setShowFPS(bool b) {
@@ -62,6 +73,7 @@ namespace Aether {
         // Remove image from background
         SDLHelper::destroyTexture(this->bgImg);
         this->bgImg = nullptr;
+        this->dropSnapshot();
     }
 
     bool Display::setBackgroundImage(std::string path) {
@@ -74,6 +86,7 @@ namespace Aether {
         SDLHelper::destroyTexture(this->bgImg);
         this->bgImg = SDLHelper::renderImage(path);
         this->bg = Colour{0, 0, 0, 255};
+        this->dropSnapshot();
         if (this->bgImg == nullptr) {
             return false;
         }
@@ -93,6 +106,11 @@ namespace Aether {
         }
     }
 
+    void Display::dropSnapshot() {
+        SDLHelper::destroyTexture(this->screenSnapshot);
+        this->screenSnapshot = nullptr;
+    }
+
     void Display::dropScreen() {
         if (this->screen != nullptr) {
             this->screen->onUnload();
@@ -148,6 +166,64 @@ namespace Aether {
         this->fadeOut = true;
     }
 
+    void Display::dispatchEvent(InputEvent * event) {
+        this->lastInput = SDL_GetTicks();
+
+        // Set touched variable
+        bool old = this->isTouch;
+        this->isTouch = (event->button() == Button::NO_BUTTON);
+
+        // Ignore first directional press or A (ie. only highlight)
+        if (old == true && this->isTouch == false && ((event->id() != FAKE_ID && (event->button() >= DPAD_LEFT && event->button() <= DPAD_DOWN)) || (event->button() == A))) {
+            return;
+        }
+
+        if (event->id() == FAKE_ID && (event->button() < DPAD_LEFT || event->button() > DPAD_DOWN)) {
+            this->isTouch = true;
+        }
+
+        if (this->overlays.size() == 0) {
+            this->screen->handleEvent(event);
+        } else {
+            this->overlays[this->overlays.size()-1]->handleEvent(event);
+        }
+    }
+
+    int Display::idleWait() {
+        // Always draw if there are pending changes
+        if (this->fps_ || this->fading || this->screen == nullptr || this->nextScreen != nullptr || this->stackOp != StackOp::None) {
+            return 0;
+        }
+        // Background tasks wake the loop as they finish, so they don't need frames while running
+        if (this->heldButton != Button::NO_BUTTON) {
+            return 0;
+        }
+
+        // Check whether anything on screen is changing (screen is frozen below overlays)
+        if (this->overlays.empty() && this->screen->isAnimating()) {
+            return 0;
+        }
+        for (size_t i = 0; i < this->overlays.size(); i++) {
+            if (this->overlays[i]->shouldClose() || this->overlays[i]->isAnimating()) {
+                return 0;
+            }
+        }
+
+        // The highlight border pulses at a low rate for a while after input, then stays as it is
+        Element * top = (this->overlays.empty() ? this->screen : this->overlays[this->overlays.size() - 1]);
+        if (!this->isTouch && top->hasHighlighted() && SDL_GetTicks() - this->lastInput < HIGHLIGHT_TIME) {
+            return HIGHLIGHT_WAIT;
+        }
+
+        return IDLE_WAIT;
+    }
+
+    void Display::wake() {
+        SDL_Event event;
+        event.type = SDL_USEREVENT;
+        SDL_PushEvent(&event);
+    }
+
     bool Display::loop() {
         // Avoid first large delta due to loading time
         if (!dtClock.init) {
@@ -162,9 +238,11 @@ namespace Aether {
             }
             this->screen = this->nextScreen;
             if (this->screen != nullptr && this->stackOp != StackOp::Pop) {
+                ElementArena::Scope scope(this->screen->arena());
                 this->screen->onLoad();
             }
             this->nextScreen = nullptr;
+            this->dropSnapshot();
         }
 
         // Reset stack operation
@@ -184,29 +262,9 @@ namespace Aether {
                 case SDL_FINGERDOWN:
                 case SDL_FINGERMOTION:
                 case SDL_FINGERUP:
-                    // Create InputEvent and pass to screen/overlay
-                    InputEvent * event = new InputEvent(e);
-
-                    // Set touched variable
-                    bool old = this->isTouch;
-                    this->isTouch = (event->button() == Button::NO_BUTTON);
-
-                    // Ignore first directional press or A (ie. only highlight)
-                    if (old == true && this->isTouch == false && ((event->id() != FAKE_ID && (event->button() >= DPAD_LEFT && event->button() <= DPAD_DOWN)) || (event->button() == A))) {
-                        delete event;
-                        break;
-                    }
-
-                    if (event->id() == FAKE_ID && (event->button() < DPAD_LEFT || event->button() > DPAD_DOWN)) {
-                        this->isTouch = true;
-                    }
-
-                    if (this->overlays.size() == 0) {
-                        this->screen->handleEvent(event);
-                    } else {
-                        this->overlays[this->overlays.size()-1]->handleEvent(event);
-                    }
-                    delete event;
+                    // Events live on the stack; nothing is allocated per event
+                    InputEvent event(e);
+                    this->dispatchEvent(&event);
                     break;
             }
 
@@ -223,9 +281,14 @@ namespace Aether {
             }
         }
 
-        // Update screen
+        // Finish background tasks whether or not the screen is covered
+        this->screen->pollTasks();
+
+        // Update screen (it can't change while covered by an overlay)
         dtClock.tick();
-        this->screen->update(dtClock.delta);
+        if (this->overlays.empty()) {
+            this->screen->update(dtClock.delta);
+        }
 
         // Update overlays
         for (size_t i = 0; i < this->overlays.size(); i++) {
@@ -234,6 +297,7 @@ namespace Aether {
                 i--;
                 if (this->overlays.size() == 0) {
                     this->screen->setActive();
+                    this->dropSnapshot();
                 } else {
                     this->overlays[this->overlays.size() - 1]->setActive();
                 }
@@ -243,39 +307,48 @@ namespace Aether {
             this->overlays[i]->update(dtClock.delta);
         }
 
-        // Push button pressed/released event if held
+        // Repeat button pressed/released event if held
         if (this->heldButton != Button::NO_BUTTON) {
             this->heldTime += dtClock.delta;
             if (this->heldTime >= this->holdDelay_) {
                 this->heldTime -= this->holdDelay_;
-                // Send pushed event
-                SDL_Event event;
-                event.type = SDL_JOYBUTTONDOWN;
-                event.jbutton.which = FAKE_ID;
-                event.jbutton.button = (uint8_t)this->heldButton;
-                event.jbutton.state = SDL_PRESSED;
-                SDL_PushEvent(&event);
-                // Send released event (so basically a verrry fast button press)
-                SDL_Event event2;
-                event2.type = SDL_JOYBUTTONUP;
-                event2.jbutton.which = FAKE_ID;
-                event2.jbutton.button = (uint8_t)this->heldButton;
-                event2.jbutton.state = SDL_RELEASED;
-                SDL_PushEvent(&event2);
+                // Dispatch a press + release directly (so basically a verrry fast button press)
+                InputEvent press(EventType::ButtonPressed, this->heldButton, FAKE_ID);
+                this->dispatchEvent(&press);
+                InputEvent release(EventType::ButtonReleased, this->heldButton, FAKE_ID);
+                this->dispatchEvent(&release);
             }
         }
 
-        // Clear screen/draw background
-        SDLHelper::clearScreen(this->bg);
-        if (this->bgImg) {
-            SDLHelper::drawTexture(this->bgImg, Colour{255, 255, 255, 255}, 0, 0, 1280, 720);
-        }
-
         // Update highlight border colour
         this->hiBorder = this->hiAnim(dtClock.last_tick);
 
-        // Render screen
-        this->screen->render();
+        // Take snapshot of background + screen when it becomes covered by an overlay, and again
+        // whenever the covered screen changes (e.g. a task or request completing)
+        if (this->screen->checkChanged()) {
+            this->dropSnapshot();
+        }
+        if (!this->overlays.empty() && this->screenSnapshot == nullptr) {
+            this->screenSnapshot = SDLHelper::createTexture(1280, 720);
+            SDLHelper::renderToTexture(this->screenSnapshot);
+            SDLHelper::drawFilledRect(this->bg, 0, 0, 1280, 720);
+            if (this->bgImg) {
+                SDLHelper::drawTexture(this->bgImg, Colour{255, 255, 255, 255}, 0, 0, 1280, 720);
+            }
+            this->screen->render();
+            SDLHelper::renderToScreen();
+        }
+
+        // Clear screen/draw background + screen (or snapshot of them)
+        SDLHelper::clearScreen(this->bg);
+        if (this->screenSnapshot != nullptr) {
+            SDLHelper::drawTexture(this->screenSnapshot, Colour{255, 255, 255, 255}, 0, 0, 1280, 720);
+        } else {
+            if (this->bgImg) {
+                SDLHelper::drawTexture(this->bgImg, Colour{255, 255, 255, 255}, 0, 0, 1280, 720);
+            }
+            this->screen->render();
+        }
 
         // Draw overlays
         for (size_t i = 0; i < this->overlays.size(); i++) {
@@ -314,9 +387,29 @@ namespace Aether {
 
         SDLHelper::draw();
 
+        // Finish startup now that something is visible
+        if (!this->shownFrame) {
+            this->shownFrame = true;
+            Trace::mark("First frame presented");
+            if (!SDLHelper::initJoystick()) {
+                this->loop_ = false;
+            }
+            Trace::flush();
+        }
+
         // Update ThreadPool
         ThreadPool::process();
 
+        // Sleep until input arrives if nothing will change
+        if (this->loop_) {
+            int wait = this->idleWait();
+            if (wait > 0) {
+                SDL_WaitEventTimeout(nullptr, wait);
+                // Don't count time spent waiting towards the next frame
+                dtClock.last_tick = SDL_GetTicks();
+            }
+        }
+
         return this->loop_;
     }
 
@@ -336,6 +429,7 @@ namespace Aether {
 
         // Clean up SDL
         SDLHelper::destroyTexture(this->bgImg);
+        this->dropSnapshot();
         SDLHelper::exitSDL();
     }
 };
\ No newline at end of file
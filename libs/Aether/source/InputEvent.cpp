@@ -2,19 +2,24 @@
 #include "Aether/utils/Utils.hpp"
 
 namespace Aether {
+    // Turn all directional events into dpad
+    static Button toDPad(Button b) {
+        if (b == Button::LSTICK_LEFT || b == Button::RSTICK_LEFT) {
+            return Button::DPAD_LEFT;
+        } else if (b == Button::LSTICK_RIGHT || b == Button::RSTICK_RIGHT) {
+            return Button::DPAD_RIGHT;
+        } else if (b == Button::LSTICK_UP || b == Button::RSTICK_UP) {
+            return Button::DPAD_UP;
+        } else if (b == Button::LSTICK_DOWN || b == Button::RSTICK_DOWN) {
+            return Button::DPAD_DOWN;
+        }
+        return b;
+    }
+
     InputEvent::InputEvent(SDL_Event e) {
-        // Turn all directional events into dpad
         Button tmp = Utils::SDLtoButton(e.jbutton.button);
         if (e.type == SDL_JOYBUTTONDOWN || e.type == SDL_JOYBUTTONUP) {
-            if (tmp == Button::LSTICK_LEFT || tmp == Button::RSTICK_LEFT) {
-                tmp = Button::DPAD_LEFT;
-            } else if (tmp == Button::LSTICK_RIGHT || tmp == Button::RSTICK_RIGHT) {
-                tmp = Button::DPAD_RIGHT;
-            } else if (tmp == Button::LSTICK_UP || tmp == Button::RSTICK_UP) {
-                tmp = Button::DPAD_UP;
-            } else if (tmp == Button::LSTICK_DOWN || tmp == Button::RSTICK_DOWN) {
-                tmp = Button::DPAD_DOWN;
-            }
+            tmp = toDPad(tmp);
         }
 
         switch (e.type) {
@@ -69,6 +74,16 @@ namespace Aether {
         }
     }
 
+    InputEvent::InputEvent(EventType t, Button b, int id) {
+        this->type_ = t;
+        this->button_ = toDPad(b);
+        this->id_ = id;
+        this->touchX_ = 0;
+        this->touchY_ = 0;
+        this->touchDX_ = 0;
+        this->touchDY_ = 0;
+    }
+
     EventType InputEvent::type() {
         return this->type_;
     }
@@ -1,3 +1,4 @@
+#include "Aether/Display.hpp"
 #include "Aether/Screen.hpp"
 
 // Size of highlight border
@@ -5,11 +6,12 @@
 
 namespace Aether {
     Screen::Screen() : Container(0, 0, 1280, 720) {
-        // Init all callbacks to nullptr to indicate none set
-        for (int i = Button::A; i < Button::SR_RIGHT; i++) {
-            this->pressFuncs[static_cast<Button>(i)] = nullptr;
-            this->releaseFuncs[static_cast<Button>(i)] = nullptr;
-        }
+        // Callbacks are empty (nullptr) until set
+        this->changed_ = true;
+    }
+
+    ElementArena & Screen::arena() {
+        return this->arena_;
     }
 
     void Screen::onLoad() {
@@ -21,15 +23,23 @@ namespace Aether {
     }
 
     void Screen::onButtonPress(Button k, std::function<void()> f) {
-        this->pressFuncs[k] = f;
+        if (k < Button::NO_BUTTON) {
+            this->pressFuncs[k] = f;
+        }
     }
 
     void Screen::onButtonRelease(Button k, std::function<void()> f) {
-        this->releaseFuncs[k] = f;
+        if (k < Button::NO_BUTTON) {
+            this->releaseFuncs[k] = f;
+        }
     }
 
     bool Screen::handleEvent(InputEvent * e) {
-        // Check for callback and execute if there is one
+        // Check for callback and execute if there is one (touch events have no button)
+        if (e->button() >= Button::NO_BUTTON) {
+            return Container::handleEvent(e);
+        }
+
         if (e->type() == EventType::ButtonPressed) {
             if (this->pressFuncs[e->button()] != nullptr) {
                 this->pressFuncs[e->button()]();
@@ -45,4 +55,57 @@ namespace Aether {
         // If no callback continue down the chain
         return Container::handleEvent(e);
     }
+
+    void Screen::runAsync(std::function<void()> task, std::function<void()> done) {
+        AsyncTask t;
+        t.finished = std::make_shared<std::atomic<bool> >(false);
+        std::shared_ptr<std::atomic<bool> > finished = t.finished;
+        t.future = std::async(std::launch::async, [task, finished]() {
+            task();
+            *finished = true;
+            Display::wake();
+        });
+        t.done = done;
+        this->tasks.push_back(std::move(t));
+    }
+
+    bool Screen::loading() {
+        return !this->tasks.empty();
+    }
+
+    void Screen::pollTasks() {
+        // Complete finished tasks (done may add more, so don't hold an iterator)
+        size_t i = 0;
+        while (i < this->tasks.size()) {
+            // The flag is set just before the thread returns, so the wait is only a moment
+            if (*this->tasks[i].finished) {
+                this->tasks[i].future.wait();
+                std::function<void()> done = this->tasks[i].done;
+                this->tasks.erase(this->tasks.begin() + i);
+                if (done != nullptr) {
+                    ElementArena::Scope scope(this->arena_);
+                    done();
+                }
+            } else {
+                i++;
+            }
+        }
+    }
+
+    void Screen::invalidate() {
+        this->changed_ = true;
+        Container::invalidate();
+    }
+
+    bool Screen::checkChanged() {
+        bool changed = this->changed_;
+        this->changed_ = false;
+        return changed;
+    }
+
+    Screen::~Screen() {
+        // Elements must be deleted while the arena they may be in still exists
+        this->removeAllElements();
+    }
+
 };
\ No newline at end of file
@@ -1,4 +1,7 @@
+#include <atomic>
+#include "Aether/Display.hpp"
 #include <future>
+#include <memory>
 #include <mutex>
 #include <queue>
 #include "Aether/ThreadPool.hpp"
@@ -8,8 +11,13 @@
 static unsigned int maxThreads = 2;
 // Queue of functions to run
 static std::queue< std::function<void()> > queue;
+// A running task, finished is set as it returns (just before the display is woken)
+struct Running {
+    std::future<void> future;
+    std::shared_ptr< std::atomic<bool> > finished;
+};
 // Vector of currently running threads (need future to remain in scope)
-static std::vector< std::future<void> > threads;
+static std::vector<Running> threads;
 // Mutexes for protecting queue + thread vector
 static std::mutex qMutex;
 static std::mutex tMutex;
@@ -30,8 +38,8 @@ namespace Aether::ThreadPool {
     void waitUntilDone() {
         std::scoped_lock<std::mutex> mtx(tMutex);
         for (size_t i = 0; i < threads.size(); i++) {
-            if (threads[i].valid()) {
-                threads[i].get();
+            if (threads[i].future.valid()) {
+                threads[i].future.get();
             }
         }
         threads.clear();
@@ -47,7 +55,8 @@ namespace Aether::ThreadPool {
         std::scoped_lock<std::mutex> tMtx(tMutex);
         int i = 0;
         while (i < threads.size()) {
-            if (threads[i].wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+            if (*threads[i].finished) {
+                threads[i].future.wait();
                 threads.erase(threads.begin() + i);
             } else {
                 i++;
@@ -61,8 +70,21 @@ namespace Aether::ThreadPool {
                 break;
             }
 
-            threads.emplace_back(std::async(std::launch::async, queue.front()));
+            // Waking the display lets it start queued tasks and use the result without polling
+            std::function<void()> f = queue.front();
+            std::shared_ptr< std::atomic<bool> > finished = std::make_shared< std::atomic<bool> >(false);
+            threads.push_back(Running{std::async(std::launch::async, [f, finished]() {
+                f();
+                *finished = true;
+                Display::wake();
+            }), finished});
             queue.pop();
         }
     }
+
+    bool idle() {
+        std::scoped_lock<std::mutex> tMtx(tMutex);
+        std::scoped_lock<std::mutex> qMtx(qMutex);
+        return (threads.empty() && queue.empty());
+    }
 };
\ No newline at end of file
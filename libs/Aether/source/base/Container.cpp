@@ -2,7 +2,12 @@
 
 namespace Aether {
     Container::Container(int x, int y, int w, int h) : Element(x, y, w, h) {
-
+        this->touched = nullptr;
+        this->cached_ = false;
+        this->layer = nullptr;
+        this->layerDirty = true;
+        this->indexPaused = false;
+        this->indexStale = false;
     }
 
     void Container::addElement(Element * e) {
@@ -12,6 +17,11 @@ namespace Aether {
     void Container::addElementAt(Element * e, size_t i) {
         e->setInactive();
         Element::addElementAt(e, i);
+        this->indexElement(e);
+        // Hits and ties follow the order of children, which an insertion before the end shifts
+        if (e != this->children.back()) {
+            this->index.reorder(this->children);
+        }
         if ((e->selectable() || e->hasSelectable()) && this->focused() == nullptr) {
             this->setFocused(e);
         }
@@ -35,42 +45,14 @@ namespace Aether {
 
                 // If children didn't handle it, shift focus between them
                 switch (e->button()) {
-                    // Cur: current element that's focused
-                    // Pot: potential element to move to
                     case Button::DPAD_RIGHT:
-                        return moveHighlight(this, [](Element * cur, Element * pot) {
-                            return (pot->x() >= cur->x() + cur->w());
-                        },
-                        [](Element * cur, Element * pot){
-                            return sqrt(pow(pot->x() - (cur->x() + cur->w()), 2) + pow((pot->y() + pot->h()/2) - (cur->y() + cur->h()/2), 2));
-                        });
-                        break;
-
                     case Button::DPAD_LEFT:
-                        return moveHighlight(this, [](Element * cur, Element * pot) {
-                            return (pot->x() + pot->w() <= cur->x());
-                        },
-                        [](Element * cur, Element * pot){
-                            return sqrt(pow((pot->x() + pot->w()) - cur->x(), 2) + pow((pot->y() + pot->h()/2) - (cur->y() + cur->h()/2), 2));
-                        });
-                        break;
-
                     case Button::DPAD_UP:
-                        return moveHighlight(this, [](Element * cur, Element * pot) {
-                            return (pot->y() + pot->h() <= cur->y());
-                        },
-                        [](Element * cur, Element * pot){
-                            return sqrt(pow((pot->x() + pot->w()/2) - (cur->x() + cur->w()/2), 2) + pow((pot->y() + pot->h()) - cur->y(), 2));
-                        });
+                    case Button::DPAD_DOWN:
+                        return this->moveFocus(e->button());
                         break;
 
-                    case Button::DPAD_DOWN:
-                        return moveHighlight(this, [](Element * cur, Element * pot) {
-                            return (pot->y() >= cur->y() + cur->h());
-                        },
-                        [](Element * cur, Element * pot){
-                            return sqrt(pow((pot->x() + pot->w()/2) - (cur->x() + cur->w()/2), 2) + pow(pot->y() - (cur->y() + cur->h()), 2));
-                        });
+                    default:
                         break;
                 }
                 break;
@@ -84,14 +66,45 @@ namespace Aether {
                 break;
 
             case EventType::TouchPressed:
+                // Only children under the touch can respond to a press
+                this->touched = nullptr;
+                this->touchHits.clear();
+                this->index.elementsAt(e->touchX() - this->childOriginX(), e->touchY() - this->childOriginY(), this->touchHits);
+                for (size_t i = 0; i < this->touchHits.size(); i++) {
+                    if (this->touchHits[i]->handleEvent(e)) {
+                        this->touched = this->touchHits[i];
+                        return true;
+                    }
+                }
+                break;
+
             case EventType::TouchMoved:
-            case EventType::TouchReleased:
-                for (size_t i = 0; i < this->children.size(); i++) {
-                    if (this->children[i]->handleEvent(e)) {
+                // Moves only matter to the child that was pressed
+                if (this->touched != nullptr) {
+                    return this->touched->handleEvent(e);
+                }
+                break;
+
+            case EventType::TouchReleased: {
+                // The pressed child gets the release first, then only children under the touch
+                Element * t = this->touched;
+                this->touched = nullptr;
+                if (t != nullptr && t->handleEvent(e)) {
+                    return true;
+                }
+                this->touchHits.clear();
+                this->index.elementsAt(e->touchX() - this->childOriginX(), e->touchY() - this->childOriginY(), this->touchHits);
+                for (size_t i = 0; i < this->touchHits.size(); i++) {
+                    // The touched child has already had the release
+                    if (this->touchHits[i] == t) {
+                        continue;
+                    }
+                    if (this->touchHits[i]->handleEvent(e)) {
                         return true;
                     }
                 }
                 break;
+            }
         }
 
         return false;
@@ -99,9 +112,113 @@ namespace Aether {
 
     void Container::removeAllElements() {
         this->setFocused(nullptr);
+        this->touched = nullptr;
+        this->index.clear();
         Element::removeAllElements();
     }
 
+    void Container::indexElement(Element * e) {
+        if (this->indexPaused) {
+            this->indexStale = true;
+            return;
+        }
+        this->index.insert(e, SDL_Rect{e->x() - this->childOriginX(), e->y() - this->childOriginY(), e->w(), e->h()});
+    }
+
+    void Container::pauseIndex() {
+        this->indexPaused = true;
+    }
+
+    void Container::resumeIndex() {
+        this->indexPaused = false;
+        if (this->indexStale) {
+            // Starting again means no element is moved out of a crowded cell one at a time
+            this->index.clear();
+            for (size_t i = 0; i < this->children.size(); i++) {
+                this->indexElement(this->children[i]);
+            }
+            this->indexStale = false;
+        }
+    }
+
+    void Container::childChanged(Element * e) {
+        this->indexElement(e);
+    }
+
+    void Container::invalidate() {
+        this->layerDirty = true;
+        Element::invalidate();
+    }
+
+    bool Container::cached() {
+        return this->cached_;
+    }
+
+    void Container::setCached(bool b) {
+        this->cached_ = b;
+        if (!b) {
+            SDLHelper::destroyTexture(this->layer);
+            this->layer = nullptr;
+        }
+        this->invalidate();
+    }
+
+    void Container::render() {
+        // Render normally if not cached (or hidden)
+        if (!this->cached_ || !this->isVisible()) {
+            Element::render();
+            return;
+        }
+
+        // Draw directly while the contents change every frame
+        if (this->highlighted() || this->selected() || this->hasSelected() || (this->hasHighlighted() && !this->isTouch) || this->isAnimating()) {
+            this->layerDirty = true;
+            Element::render();
+            return;
+        }
+
+        // (Re)create layer if size has changed
+        if (this->layer != nullptr) {
+            int w, h;
+            SDLHelper::getDimensions(this->layer, &w, &h);
+            if (w != this->w() || h != this->h()) {
+                SDLHelper::destroyTexture(this->layer);
+                this->layer = nullptr;
+            }
+        }
+        if (this->layer == nullptr) {
+            this->layer = SDLHelper::createTexture(this->w(), this->h());
+            this->layerDirty = true;
+        }
+
+        // Redraw children into the layer (restoring whatever was being rendered to afterwards)
+        if (this->layerDirty) {
+            SDL_Texture * target = SDLHelper::getRenderTarget();
+            int ox, oy;
+            SDLHelper::getOffset(&ox, &oy);
+            SDL_BlendMode bld = SDLHelper::getBlendMode();
+
+            SDLHelper::renderToTexture(this->layer);
+            SDLHelper::setBlendMode(SDL_BLENDMODE_NONE);
+            SDLHelper::setOffset(-this->x(), -this->y());
+            Element::render();
+
+            SDLHelper::setOffset(ox, oy);
+            SDLHelper::setBlendMode(bld);
+            SDLHelper::setRenderTarget(target);
+            this->layerDirty = false;
+        }
+
+        SDLHelper::drawTexture(this->layer, Colour{255, 255, 255, 255}, this->x(), this->y(), this->w(), this->h());
+    }
+
+    void Container::childRemoved(Element * e) {
+        if (this->touched == e) {
+            this->touched = nullptr;
+        }
+        this->index.remove(e);
+    }
+
     void Container::setActive() {
         if (this->focused() != nullptr) {
             this->focused()->setActive();
@@ -114,30 +231,18 @@ namespace Aether {
         }
     }
 
-    bool moveHighlight(Container * parent, std::function<bool(Element *, Element*)> check, std::function<int(Element *, Element *)> dist) {
-        int minDist = std::numeric_limits<int>::max();
-        Element * mv = nullptr;
-
-        // Iterate over all children and keep valid one with smallest distance
-        for (size_t i = 0; i < parent->children.size(); i++) {
-            if (parent->children[i] == parent->focused() || parent->children[i]->hidden() || !(parent->children[i]->selectable() || parent->children[i]->hasSelectable())) {
-                continue;
-            }
-
-            if (check(parent->focused(), parent->children[i])) {
-                int tmpDist = dist(parent->focused(), parent->children[i]);
-                if (tmpDist < minDist) {
-                    minDist = tmpDist;
-                    mv = parent->children[i];
-                }
-            }
-        }
+    bool Container::moveFocus(Button b) {
+        Element * mv = this->index.nearest(this->focused(), b);
 
         // If one found change focus
         if (mv != nullptr) {
-            parent->setFocused(mv);
+            this->setFocused(mv);
             return true;
         }
         return false;
     }
+
+    Container::~Container() {
+        SDLHelper::destroyTexture(this->layer);
+    }
 };
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include <algorithm>
 #include "Aether/base/Element.hpp"
 #include <limits>
+#include <new>
 
 // Border size of highlight
 #define HIGHLIGHT_SIZE 6
@@ -11,11 +12,49 @@ namespace Aether {
     Colour Element::hiSel = Colour{255, 255, 255, 255};
     unsigned int Element::hiSize = HIGHLIGHT_SIZE;
     bool Element::isTouch = false;
+    uint64_t Element::moveGeneration = 1;
+
+    // Header stored before each element to record where its memory came from
+    union AllocHeader {
+        ElementArena * arena;
+        std::max_align_t align;
+    };
+
+    void * Element::operator new(size_t n) {
+        ElementArena * arena = ElementArena::active();
+        void * mem = (arena == nullptr ? nullptr : arena->allocate(sizeof(AllocHeader) + n));
+        // Fall back to the heap if the arena couldn't get another block
+        if (mem == nullptr) {
+            arena = nullptr;
+            mem = ::operator new(sizeof(AllocHeader) + n);
+        }
+        AllocHeader * h = static_cast<AllocHeader *>(mem);
+        h->arena = arena;
+        return h + 1;
+    }
+
+    void Element::operator delete(void * p) {
+        if (p == nullptr) {
+            return;
+        }
+
+        AllocHeader * h = static_cast<AllocHeader *>(p) - 1;
+        if (h->arena == nullptr) {
+            ::operator delete(h);
+        } else {
+            h->arena->release();
+        }
+    }
 
     Element::Element(int x, int y, int w, int h) {
+        // Parent must be set first as positions are relative to it
+        this->parent_ = nullptr;
+        this->layoutPending_ = false;
+        this->childOffsetX_ = 0;
+        this->childOffsetY_ = 0;
+        this->absGeneration_ = 0;
         this->setXYWH(x, y, w, h);
 
-        this->parent_ = nullptr;
         this->hidden_ = false;
         this->callback_ = nullptr;
         this->hasSelectable_ = false;
@@ -29,12 +68,51 @@ namespace Aether {
         this->focused_ = nullptr;
     }
 
+    int Element::originX() {
+        if (this->parent_ == nullptr) {
+            return 0;
+        }
+        return this->parent_->childOriginX();
+    }
+
+    int Element::originY() {
+        if (this->parent_ == nullptr) {
+            return 0;
+        }
+        return this->parent_->childOriginY();
+    }
+
+    void Element::updatePosition() {
+        if (this->absGeneration_ == moveGeneration) {
+            return;
+        }
+
+        // The parent's origin comes from its own cache, so this only walks up as far as the first valid one
+        this->absX_ = this->originX() + this->x_;
+        this->absY_ = this->originY() + this->y_;
+        this->absGeneration_ = moveGeneration;
+    }
+
+    void Element::positionsChanged() {
+        moveGeneration++;
+    }
+
+    int Element::childOriginX() {
+        return this->x() + this->childOffsetX_;
+    }
+
+    int Element::childOriginY() {
+        return this->y() + this->childOffsetY_;
+    }
+
     int Element::x() {
-        return this->x_;
+        this->updatePosition();
+        return this->absX_;
     }
 
     int Element::y() {
-        return this->y_;
+        this->updatePosition();
+        return this->absY_;
     }
 
     int Element::w() {
@@ -46,27 +124,37 @@ namespace Aether {
     }
 
     void Element::setX(int x) {
-        int diff = x - this->x();
-        this->x_ = x;
-        for (size_t i = 0; i < this->children.size(); i++) {
-            this->children[i]->setX(this->children[i]->x() + diff);
+        this->x_ = x - this->originX();
+        positionsChanged();
+        if (this->parent_ != nullptr) {
+            this->parent_->childChanged(this);
+            this->parent_->invalidate();
         }
     }
 
     void Element::setY(int y) {
-        int diff = y - this->y();
-        this->y_ = y;
-        for (size_t i = 0; i < this->children.size(); i++) {
-            this->children[i]->setY(this->children[i]->y() + diff);
+        this->y_ = y - this->originY();
+        positionsChanged();
+        if (this->parent_ != nullptr) {
+            this->parent_->childChanged(this);
+            this->parent_->invalidate();
         }
     }
 
     void Element::setW(int w) {
         this->w_ = w;
+        if (this->parent_ != nullptr) {
+            this->parent_->childChanged(this);
+            this->parent_->invalidate();
+        }
     }
 
     void Element::setH(int h) {
         this->h_ = h;
+        if (this->parent_ != nullptr) {
+            this->parent_->childChanged(this);
+            this->parent_->invalidate();
+        }
     }
 
     void Element::setXY(int x, int y) {
@@ -89,7 +177,49 @@ namespace Aether {
     }
 
     void Element::setParent(Element * p) {
+        // Keep the same absolute position under the new parent
+        int x = this->x();
+        int y = this->y();
         this->parent_ = p;
+        this->x_ = x - this->originX();
+        this->y_ = y - this->originY();
+        positionsChanged();
+    }
+
+    void Element::setChildOffset(int x, int y) {
+        if (x != this->childOffsetX_ || y != this->childOffsetY_) {
+            this->childOffsetX_ = x;
+            this->childOffsetY_ = y;
+            positionsChanged();
+        }
+        this->invalidate();
+    }
+
+    void Element::invalidate() {
+        if (this->parent_ != nullptr) {
+            this->parent_->invalidate();
+        }
+    }
+
+    void Element::requestLayout() {
+        // Stop at the first element already marked, as it's ancestors will be too
+        Element * e = this;
+        while (e != nullptr && !e->layoutPending_) {
+            e->layoutPending_ = true;
+            e = e->parent_;
+        }
+    }
+
+    bool Element::layoutPending() {
+        return this->layoutPending_;
+    }
+
+    void Element::childChanged(Element * e) {
+
+    }
+
+    void Element::childRemoved(Element * e) {
+
     }
 
     void Element::addElement(Element * e) {
@@ -111,6 +241,10 @@ namespace Aether {
             this->setHasHighlighted(true);
         }
         this->children.insert(this->children.begin() + i, e);
+        if (e->layoutPending()) {
+            this->requestLayout();
+        }
+        this->invalidate();
     }
 
     bool Element::removeElement(Element * e) {
@@ -124,10 +258,11 @@ namespace Aether {
     }
 
     void Element::removeAllElements() {
-        while (this->children.size() > 0) {
-            delete this->children[0];
-            this->children.erase(this->children.begin());
+        // Delete everything first and clear once (erasing from the front each time is quadratic)
+        for (size_t i = 0; i < this->children.size(); i++) {
+            delete this->children[i];
         }
+        this->children.clear();
     }
 
     bool Element::isVisible() {
@@ -143,7 +278,10 @@ namespace Aether {
     }
 
     void Element::setHidden(bool b) {
-        this->hidden_ = b;
+        if (this->hidden_ != b) {
+            this->hidden_ = b;
+            this->invalidate();
+        }
     }
 
     bool Element::selected() {
@@ -152,6 +290,7 @@ namespace Aether {
 
     void Element::setSelected(bool b) {
         this->selected_ = b;
+        this->invalidate();
         if (this->parent_ != nullptr) {
             this->parent_->setHasSelected(b);
         }
@@ -180,6 +319,7 @@ namespace Aether {
 
     void Element::setHighlighted(bool b) {
         this->highlighted_ = b;
+        this->invalidate();
         if (this->parent_ != nullptr) {
             this->parent_->setHasHighlighted(b);
         }
@@ -188,7 +328,7 @@ namespace Aether {
         }
     }
 
-    std::function<void()> Element::callback() {
+    const std::function<void()> & Element::callback() {
         return this->callback_;
     }
 
@@ -263,6 +403,33 @@ namespace Aether {
         }
     }
 
+    bool Element::isAnimating() {
+        // Hidden elements aren't updated so can't change
+        if (!this->isVisible()) {
+            return false;
+        }
+
+        for (size_t i = 0; i < this->children.size(); i++) {
+            if (this->children[i]->isAnimating()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void Element::layout() {
+        // Only subtrees containing a change are walked
+        if (!this->layoutPending_) {
+            return;
+        }
+
+        // Cleared first so requests made while laying out children are kept
+        this->layoutPending_ = false;
+        for (size_t i = 0; i < this->children.size(); i++) {
+            this->children[i]->layout();
+        }
+    }
+
     bool Element::hasHighlighted() {
         return this->hasHighlighted_;
     }
@@ -388,6 +555,8 @@ namespace Aether {
             if (this->parent_->focused() == this) {
                 this->parent_->setFocused(nullptr);
             }
+            this->parent_->childRemoved(this);
+            this->parent_->invalidate();
         }
         this->removeAllElements();
     }
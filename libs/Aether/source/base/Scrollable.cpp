@@ -1,4 +1,5 @@
 #include "Aether/base/Scrollable.hpp"
+#include <limits>
 
 // Default catchup amount
 #define DEFAULT_CATCHUP 6
@@ -29,6 +30,8 @@ namespace Aether {
         this->scrollPos_ = 0;
         this->maxScrollPos_ = 0;
         this->showScrollBar_ = true;
+        this->updateDepth = 0;
+        this->layoutDirty = false;
         if (this->scrollBar == nullptr) {
             this->scrollBar = SDLHelper::renderFilledRect(5, SCROLLBAR_SIZE);
         }
@@ -77,6 +80,14 @@ namespace Aether {
         this->maxScrollPos_ -= this->h();
     }
 
+    void Scrollable::positionChildren() {
+        int y = this->y() + PADDING - this->scrollPos_;
+        for (size_t i = 0; i < this->children.size(); i++) {
+            this->children[i]->setY(y);
+            y += this->children[i]->h();
+        }
+    }
+
     void Scrollable::stopScrolling() {
         // Move highlight to top element if not visible
         if (this->isScrolling) {
@@ -163,7 +174,6 @@ namespace Aether {
     }
 
     void Scrollable::setScrollPos(int pos) {
-        unsigned int old = this->scrollPos_;
         if (pos < 0) {
             this->scrollPos_ = 0;
         } else if (pos > this->maxScrollPos_) {
@@ -172,11 +182,33 @@ namespace Aether {
             this->scrollPos_ = pos;
         }
 
-        // Update children positions
-        if (old != this->scrollPos_) {
-            for (size_t i = 0; i < this->children.size(); i++) {
-                this->children[i]->setY(this->children[i]->y() - (this->scrollPos_ - old));
-            }
+        // Children are positioned relative to the scroll offset
+        this->setChildOffset(0, -static_cast<int>(this->scrollPos_));
+    }
+
+    void Scrollable::beginUpdate() {
+        // Children are indexed once they are in place
+        if (this->updateDepth == 0) {
+            this->pauseIndex();
+        }
+        this->updateDepth++;
+    }
+
+    void Scrollable::endUpdate() {
+        if (this->updateDepth == 0) {
+            return;
+        }
+
+        this->updateDepth--;
+        if (this->updateDepth == 0 && this->layoutDirty) {
+            // Limit first (scroll position may have been changed during the update), then position
+            this->updateMaxScrollPos();
+            this->setScrollPos(this->scrollPos_);
+            this->positionChildren();
+            this->layoutDirty = false;
+        }
+        if (this->updateDepth == 0) {
+            this->resumeIndex();
         }
     }
 
@@ -187,6 +219,15 @@ namespace Aether {
     void Scrollable::addElementAt(Element * e, size_t i) {
         // Position element at correct position
         e->setX(this->x() + this->paddingAmount());
+
+        // Vertical position is sorted out by endUpdate() when batching
+        if (this->updateDepth > 0) {
+            e->setW(this->w() - 2*this->paddingAmount());
+            Container::addElementAt(e, i);
+            this->layoutDirty = true;
+            return;
+        }
+
         if (i == 0) {
             if (this->children.empty()) {
                 e->setY(this->y() + PADDING);
@@ -212,7 +253,7 @@ namespace Aether {
     bool Scrollable::addElementAfter(Element * e, Element * a) {
         // Handle nullptr
         if (a == nullptr) {
-            Container::addElementAt(e, 0);
+            this->addElementAt(e, 0);
             return true;
         }
 
@@ -242,7 +283,12 @@ namespace Aether {
 
         // Insert at position
         this->addElementAt(e, std::distance(this->children.begin(), it));
-        this->setScrollPos(this->scrollPos_ + e->h());
+        if (this->updateDepth > 0) {
+            // Limit isn't known yet, endUpdate() will clamp it
+            this->scrollPos_ += e->h();
+        } else {
+            this->setScrollPos(this->scrollPos_ + e->h());
+        }
         return true;
     }
 
@@ -269,6 +315,11 @@ namespace Aether {
             delete this->children[i];
             this->children.erase(this->children.begin() + i);
 
+            if (this->updateDepth > 0) {
+                this->layoutDirty = true;
+                return true;
+            }
+
             // Recalculate y values
             for (size_t j = i; j < this->children.size(); j++) {
                 this->children[j]->setY(this->children[j]->y() - h);
@@ -285,6 +336,10 @@ namespace Aether {
         this->stopScrolling();
         Container::removeAllElements();
         this->setScrollPos(0);
+        if (this->updateDepth > 0) {
+            this->layoutDirty = true;
+            return;
+        }
         this->updateMaxScrollPos();
     }
 
@@ -293,16 +348,20 @@ namespace Aether {
         // If the element was found loop over remaining elements and delete
         if (it != this->children.end()) {
             size_t i = std::distance(this->children.begin(), it);
-            i++;
-            while (i < this->children.size()) {
+            for (size_t j = i + 1; j < this->children.size(); j++) {
                 // If an element is focussed change focus to the 'after' element
-                if (this->focussed() == this->children[i]) {
+                if (this->focussed() == this->children[j]) {
                     this->setFocussed(e);
                 }
 
                 // We don't call Element::removeElement to avoid the repeated finds
-                delete this->children[i];
-                this->children.erase(this->children.begin() + i);
+                delete this->children[j];
+            }
+            this->children.erase(this->children.begin() + i + 1, this->children.end());
+
+            if (this->updateDepth > 0) {
+                this->layoutDirty = true;
+                return true;
             }
 
             // Update scrolling vars
@@ -326,17 +385,22 @@ namespace Aether {
             }
 
             int decH = 0;
-            while (i >= 0) {
+            for (long j = i; j >= 0; j--) {
                 // If an element is focussed change focus to the 'before' element
-                if (this->focussed() == this->children[i]) {
+                if (this->focussed() == this->children[j]) {
                     this->setFocussed(e);
                 }
 
                 // We don't call Element::removeElement to avoid the repeated finds
-                decH += this->children[i]->h();
-                delete this->children[i];
-                this->children.erase(this->children.begin() + i);
-                i--;
+                decH += this->children[j]->h();
+                delete this->children[j];
+            }
+            this->children.erase(this->children.begin(), this->children.begin() + i + 1);
+
+            if (this->updateDepth > 0) {
+                this->scrollPos_ = (this->scrollPos_ > e->h() ? this->scrollPos_ - e->h() : 0);
+                this->layoutDirty = true;
+                return true;
             }
 
             // Recalculate y values
@@ -457,7 +521,19 @@ namespace Aether {
         }
     }
 
+    bool Scrollable::isAnimating() {
+        if (this->isVisible() && (this->isScrolling || this->isTouched)) {
+            return true;
+        }
+        return Container::isAnimating();
+    }
+
     void Scrollable::render() {
+        // Remember current target as this may be inside a cached layer
+        SDL_Texture * target = SDLHelper::getRenderTarget();
+        int ox, oy;
+        SDLHelper::getOffset(&ox, &oy);
+
         SDLHelper::renderToTexture(this->renderTex);
         SDL_BlendMode bld = SDLHelper::getBlendMode();
         SDLHelper::setBlendMode(SDL_BLENDMODE_NONE);
@@ -465,10 +541,10 @@ namespace Aether {
 
         Container::render();
 
-        // Reset all rendering calls to screen
-        SDLHelper::setOffset(0, 0);
+        // Reset all rendering calls to previous target
+        SDLHelper::setOffset(ox, oy);
         SDLHelper::setBlendMode(bld);
-        SDLHelper::renderToScreen();
+        SDLHelper::setRenderTarget(target);
 
         // Render texture
         SDLHelper::drawTexture(this->renderTex, Colour{255, 255, 255, 255}, this->x(), this->y(), this->w(), this->h());
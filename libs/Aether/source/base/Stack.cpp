@@ -0,0 +1,281 @@
+#include "Aether/base/Stack.hpp"
+#include <algorithm>
+
+namespace Aether {
+    Stack::Stack(int x, int y, int w, int h, Direction d) : Container(x, y, w, h) {
+        this->direction_ = d;
+        this->align_ = Align::Start;
+        this->padding_ = 0;
+        this->gap_ = 0;
+        this->fitContent_ = false;
+        this->dirty = false;
+        this->laying = false;
+    }
+
+    void Stack::markDirty() {
+        this->dirty = true;
+        this->requestLayout();
+    }
+
+    int Stack::mainSize(Element * e) {
+        return (this->direction_ == Direction::Vertical ? e->h() : e->w());
+    }
+
+    void Stack::addElementAt(Element * e, size_t i) {
+        Container::addElementAt(e, i);
+        this->markDirty();
+    }
+
+    void Stack::childChanged(Element * e) {
+        Container::childChanged(e);
+        if (this->laying) {
+            return;
+        }
+
+        // A growing child resized by something other than the stack has a new base size
+        std::unordered_map<Element *, Base>::iterator it = this->base_.find(e);
+        if (it != this->base_.end() && this->mainSize(e) != it->second.grown) {
+            it->second.size = this->mainSize(e);
+            it->second.grown = it->second.size;
+        }
+        this->markDirty();
+    }
+
+    void Stack::childRemoved(Element * e) {
+        Container::childRemoved(e);
+        this->grow_.erase(e);
+        this->base_.erase(e);
+        this->markDirty();
+    }
+
+    Direction Stack::direction() {
+        return this->direction_;
+    }
+
+    void Stack::setDirection(Direction d) {
+        // Growing children return to their base size, as it's measured along the old direction
+        if (d != this->direction_) {
+            this->resetBases();
+        }
+        this->direction_ = d;
+        this->markDirty();
+    }
+
+    Align Stack::align() {
+        return this->align_;
+    }
+
+    void Stack::setAlign(Align a) {
+        this->align_ = a;
+        this->markDirty();
+    }
+
+    int Stack::padding() {
+        return this->padding_;
+    }
+
+    void Stack::setPadding(int p) {
+        this->padding_ = (p < 0 ? 0 : p);
+        this->markDirty();
+    }
+
+    int Stack::gap() {
+        return this->gap_;
+    }
+
+    void Stack::setGap(int g) {
+        this->gap_ = (g < 0 ? 0 : g);
+        this->markDirty();
+    }
+
+    bool Stack::fitContent() {
+        return this->fitContent_;
+    }
+
+    void Stack::setFitContent(bool b) {
+        // Growing children return to their base size, as they don't grow while sizing to fit
+        if (b && !this->fitContent_) {
+            this->resetBases();
+        }
+        this->fitContent_ = b;
+        this->markDirty();
+    }
+
+    unsigned int Stack::grow(Element * e) {
+        std::unordered_map<Element *, unsigned int>::iterator it = this->grow_.find(e);
+        return (it == this->grow_.end() ? 0 : it->second);
+    }
+
+    void Stack::setGrow(Element * e, unsigned int g) {
+        if (g == 0) {
+            // Shrink back to the size it had before growing
+            std::unordered_map<Element *, Base>::iterator it = this->base_.find(e);
+            if (it != this->base_.end()) {
+                this->setMainSize(e, it->second.size);
+                this->base_.erase(it);
+            }
+            this->grow_.erase(e);
+        } else {
+            if (this->base_.find(e) == this->base_.end()) {
+                this->base_[e] = Base{this->mainSize(e), this->mainSize(e)};
+            }
+            this->grow_[e] = g;
+        }
+        this->markDirty();
+    }
+
+    void Stack::addElement(Element * e, unsigned int g) {
+        // Container::addElement() wouldn't reach our addElementAt()
+        this->addElementAt(e, this->children.size());
+        if (g > 0) {
+            this->setGrow(e, g);
+        }
+    }
+
+    void Stack::addElement(Element * e) {
+        this->addElement(e, 0);
+    }
+
+    void Stack::setMainSize(Element * e, int s) {
+        this->laying = true;
+        if (this->direction_ == Direction::Vertical) {
+            e->setH(s);
+        } else {
+            e->setW(s);
+        }
+        this->laying = false;
+    }
+
+    void Stack::resetBases() {
+        std::unordered_map<Element *, Base>::iterator it;
+        for (it = this->base_.begin(); it != this->base_.end(); it++) {
+            this->setMainSize(it->first, it->second.size);
+            it->second.grown = it->second.size;
+        }
+    }
+
+    void Stack::arrange() {
+        bool vert = (this->direction_ == Direction::Vertical);
+
+        // Total size of children along the stack (and largest across it), growing
+        // children are measured at their base size so they don't keep growing
+        int main = 0;
+        int cross = 0;
+        unsigned int totalGrow = 0;
+        for (size_t i = 0; i < this->children.size(); i++) {
+            Element * e = this->children[i];
+            std::unordered_map<Element *, Base>::iterator it = this->base_.find(e);
+            main += (it == this->base_.end() || this->fitContent_ ? this->mainSize(e) : it->second.size);
+            cross = std::max(cross, (vert ? e->w() : e->h()));
+            if (!this->fitContent_) {
+                totalGrow += this->grow(e);
+            }
+        }
+        if (!this->children.empty()) {
+            main += this->gap_ * (this->children.size() - 1);
+        }
+
+        if (this->fitContent_) {
+            // Use the container's setters so our own don't mark the stack as dirty again
+            if (vert) {
+                Container::setW(cross + 2*this->padding_);
+                Container::setH(main + 2*this->padding_);
+            } else {
+                Container::setW(main + 2*this->padding_);
+                Container::setH(cross + 2*this->padding_);
+            }
+        }
+
+        int avail = (vert ? this->h() : this->w()) - 2*this->padding_;
+        int availCross = (vert ? this->w() : this->h()) - 2*this->padding_;
+
+        // Share left over space between growing children, last one takes the remainder
+        int spare = std::max(0, avail - main);
+        int pos = this->padding_;
+        for (size_t i = 0; i < this->children.size(); i++) {
+            Element * e = this->children[i];
+            int g = this->grow(e);
+            if (totalGrow > 0 && g > 0) {
+                int extra = (spare * g) / totalGrow;
+                spare -= extra;
+                totalGrow -= g;
+                Base & base = this->base_[e];
+                base.grown = base.size + extra;
+                if (vert) {
+                    e->setH(base.grown);
+                } else {
+                    e->setW(base.grown);
+                }
+            }
+
+            int size = (vert ? e->w() : e->h());
+            int off = this->padding_;
+            switch (this->align_) {
+                case Align::Centre:
+                    off += (availCross - size)/2;
+                    break;
+
+                case Align::End:
+                    off += availCross - size;
+                    break;
+
+                default:
+                    break;
+            }
+
+            if (vert) {
+                e->setXY(this->x() + off, this->y() + pos);
+                pos += e->h();
+            } else {
+                e->setXY(this->x() + pos, this->y() + off);
+                pos += e->w();
+            }
+            pos += this->gap_;
+        }
+    }
+
+    void Stack::layout() {
+        if (!this->layoutPending()) {
+            return;
+        }
+
+        // Children first as nested stacks may change size
+        Container::layout();
+        if (!this->dirty) {
+            return;
+        }
+
+        this->laying = true;
+        this->arrange();
+        this->laying = false;
+        this->dirty = false;
+
+        // Grown children may need to lay themselves out again
+        Container::layout();
+    }
+
+    void Stack::setW(int w) {
+        Container::setW(w);
+        if (!this->laying) {
+            this->markDirty();
+        }
+    }
+
+    void Stack::setH(int h) {
+        Container::setH(h);
+        if (!this->laying) {
+            this->markDirty();
+        }
+    }
+
+    void Stack::update(uint32_t dt) {
+        // Nothing is walked unless something below has changed
+        this->layout();
+        Container::update(dt);
+    }
+
+    void Stack::render() {
+        this->layout();
+        Container::render();
+    }
+};
@@ -65,6 +65,7 @@ namespace Aether {
 
     void Texture::setColour(Colour c) {
         this->colour = c;
+        this->invalidate();
     }
 
     void Texture::setColour(uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
@@ -83,6 +84,7 @@ namespace Aether {
         this->maskY = dy;
         this->maskW = dw;
         this->maskH = dh;
+        this->invalidate();
     }
 
     void Texture::destroyTexture() {
@@ -108,6 +110,7 @@ namespace Aether {
             }
             this->status = ThreadedStatus::Empty;
         }
+        this->invalidate();
     }
 
     bool Texture::startRendering() {
@@ -136,6 +139,13 @@ namespace Aether {
         Element::update(dt);
     }
 
+    bool Texture::isAnimating() {
+        if (this->status == ThreadedStatus::Queued || this->status == ThreadedStatus::Surface) {
+            return true;
+        }
+        return Element::isAnimating();
+    }
+
     void Texture::render() {
         if (this->hidden()) {
             return;
@@ -2,7 +2,8 @@
 
 namespace Aether {
     Controls::Controls(int x, int y, int w, int h) : Container(x, y, w, h) {
-
+        // Items rarely change so draw them from a cached layer
+        this->setCached(true);
     }
 
     void Controls::addItem(ControlItem * i) {
@@ -11,6 +11,7 @@ namespace Aether {
         this->heldButton = Button::NO_BUTTON;
         this->scroll = false;
         this->wrapAround_ = false;
+        this->moving = false;
     }
 
     bool List::wrapAround() {
@@ -86,20 +87,17 @@ namespace Aether {
 
     void List::update(uint32_t dt) {
         Scrollable::update(dt);
+        int old = this->scrollPos();
 
         // Allow "manual" scrolling at top and bottom
-        if (this->scroll) {
-            if (this->heldButton == Button::DPAD_DOWN) {
-                this->setScrollPos(this->scrollPos() + (500 * (dt/1000.0)));
-                return;
-            } else if (this->heldButton == Button::DPAD_UP) {
-                this->setScrollPos(this->scrollPos() - (500 * (dt/1000.0)));
-                return;
-            }
-        }
+        if (this->scroll && this->heldButton == Button::DPAD_DOWN) {
+            this->setScrollPos(this->scrollPos() + (500 * (dt/1000.0)));
+
+        } else if (this->scroll && this->heldButton == Button::DPAD_UP) {
+            this->setScrollPos(this->scrollPos() - (500 * (dt/1000.0)));
 
         // If focused element is not completely inside list scroll to it
-        if (!this->isScrolling && !this->isTouched && !this->isTouch && this->maxScrollPos() != 0 && this->focused() != nullptr) {
+        } else if (!this->isScrolling && !this->isTouched && !this->isTouch && this->maxScrollPos() != 0 && this->focused() != nullptr) {
             // Check if above
             if (this->focused()->y() < this->y() + PADDING) {
                 this->setScrollPos(this->scrollPos() + (this->scrollCatchup * (this->focused()->y() - (this->y() + PADDING)) * (dt/1000.0)));
@@ -109,5 +107,15 @@ namespace Aether {
                 this->setScrollPos(this->scrollPos() - (this->scrollCatchup * ((this->y() + this->h() - (PADDING*2)) - (this->focused()->y() + this->focused()->h())) * (dt/1000.0)));
             }
         }
+
+        // Catching up stops once the remaining distance rounds to nothing
+        this->moving = (this->scrollPos() != old);
+    }
+
+    bool List::isAnimating() {
+        if (this->isVisible() && this->moving) {
+            return true;
+        }
+        return Scrollable::isAnimating();
     }
 };
\ No newline at end of file
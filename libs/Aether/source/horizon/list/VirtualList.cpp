@@ -0,0 +1,222 @@
+#include "Aether/horizon/list/VirtualList.hpp"
+
+// Time a direction must be held before it repeats (in ms)
+#define HOLD_DELAY 400
+// Time between each repeat while held (in ms)
+#define REPEAT_TIME 40
+
+namespace Aether {
+    VirtualList::VirtualList(int x, int y, int w, int h, unsigned int r, unsigned int f) : Element(x, y, w, h) {
+        this->rows_ = 0;
+        this->topRow_ = 0;
+        this->rowHeight_ = (r == 0 ? 1 : r);
+        this->fontSize_ = f;
+        this->textColour = Colour{255, 255, 255, 255};
+        this->heldButton = Button::NO_BUTTON;
+        this->holdTime = 0;
+        this->isTouched = false;
+        this->touchY = 0;
+        this->createSlots();
+    }
+
+    void VirtualList::createSlots() {
+        for (size_t i = 0; i < this->slots.size(); i++) {
+            this->removeElement(this->slots[i]);
+        }
+        this->slots.clear();
+        this->slotRows.clear();
+
+        ElementArena::Scope scope(this->slotArena);
+        size_t count = this->visibleRows();
+        for (size_t i = 0; i < count; i++) {
+            Text * t = new Text(0, 0, "", this->fontSize_);
+            t->setColour(this->textColour);
+            t->setHidden(true);
+            this->slots.push_back(t);
+            this->slotRows.push_back(this->rows_);
+            this->addElement(t);
+        }
+    }
+
+    void VirtualList::updateSlots() {
+        if (this->slots.empty()) {
+            return;
+        }
+
+        for (size_t i = 0; i < this->slots.size(); i++) {
+            size_t row = this->topRow_ + i;
+            Text * t = this->slots[row % this->slots.size()];
+            if (row >= this->rows_) {
+                t->setHidden(true);
+                continue;
+            }
+
+            // Only rows which weren't visible before need their text rendered
+            size_t & slotRow = this->slotRows[row % this->slots.size()];
+            if (slotRow != row) {
+                t->setString(this->rowFunc(row));
+                slotRow = row;
+            }
+            t->setXY(this->x(), this->y() + i*this->rowHeight_ + (static_cast<int>(this->rowHeight_) - t->h())/2);
+            t->setHidden(false);
+        }
+    }
+
+    long VirtualList::buttonRows(Button b) {
+        // Left and right keep one row of the old page in view
+        long page = (this->visibleRows() > 1 ? this->visibleRows() - 1 : 1);
+        switch (b) {
+            case Button::DPAD_UP:
+                return -1;
+
+            case Button::DPAD_DOWN:
+                return 1;
+
+            case Button::DPAD_LEFT:
+                return -page;
+
+            case Button::DPAD_RIGHT:
+                return page;
+
+            default:
+                return 0;
+        }
+    }
+
+    bool VirtualList::moveRows(long d) {
+        size_t old = this->topRow_;
+        if (d < 0) {
+            this->setTopRow(this->topRow_ < static_cast<size_t>(-d) ? 0 : this->topRow_ + d);
+        } else {
+            this->setTopRow(this->topRow_ + d);
+        }
+        return (this->topRow_ != old);
+    }
+
+    void VirtualList::setRows(size_t n, std::function<std::string(size_t)> f) {
+        this->rows_ = n;
+        this->rowFunc = f;
+        this->topRow_ = 0;
+        this->refresh();
+    }
+
+    size_t VirtualList::rows() {
+        return this->rows_;
+    }
+
+    size_t VirtualList::topRow() {
+        return this->topRow_;
+    }
+
+    void VirtualList::setTopRow(size_t r) {
+        // Don't scroll past the point where the last row is at the bottom
+        size_t visible = this->visibleRows();
+        size_t max = (this->rows_ > visible ? this->rows_ - visible : 0);
+        this->topRow_ = (r > max ? max : r);
+        this->updateSlots();
+    }
+
+    size_t VirtualList::visibleRows() {
+        return (this->h() > 0 ? this->h() / this->rowHeight_ : 0);
+    }
+
+    void VirtualList::refresh() {
+        for (size_t i = 0; i < this->slotRows.size(); i++) {
+            this->slotRows[i] = this->rows_;
+        }
+        this->setTopRow(this->topRow_);
+    }
+
+    void VirtualList::setTextColour(Colour c) {
+        this->textColour = c;
+        for (size_t i = 0; i < this->slots.size(); i++) {
+            this->slots[i]->setColour(c);
+        }
+    }
+
+    void VirtualList::setH(int h) {
+        Element::setH(h);
+        this->createSlots();
+        this->refresh();
+    }
+
+    bool VirtualList::handleEvent(InputEvent * e) {
+        switch (e->type()) {
+            case EventType::ButtonPressed:
+                if (this->buttonRows(e->button()) != 0) {
+                    if (this->moveRows(this->buttonRows(e->button()))) {
+                        this->heldButton = e->button();
+                        this->holdTime = 0;
+                        return true;
+                    }
+                }
+                break;
+
+            case EventType::ButtonReleased:
+                if (e->button() == this->heldButton) {
+                    this->heldButton = Button::NO_BUTTON;
+                    return true;
+                }
+                break;
+
+            case EventType::TouchPressed:
+                if (e->touchX() >= this->x() && e->touchX() <= this->x() + this->w() && e->touchY() >= this->y() && e->touchY() <= this->y() + this->h()) {
+                    this->isTouched = true;
+                    this->touchY = e->touchY();
+                    return true;
+                }
+                break;
+
+            case EventType::TouchMoved:
+                if (this->isTouched) {
+                    // Dragging up moves down the list, a row for every row height moved
+                    long d = (this->touchY - e->touchY()) / static_cast<int>(this->rowHeight_);
+                    if (d != 0) {
+                        this->moveRows(d);
+                        this->touchY -= d * static_cast<int>(this->rowHeight_);
+                    }
+                    return true;
+                }
+                break;
+
+            case EventType::TouchReleased:
+                if (this->isTouched) {
+                    this->isTouched = false;
+                    return true;
+                }
+                break;
+        }
+
+        return false;
+    }
+
+    void VirtualList::update(uint32_t dt) {
+        Element::update(dt);
+
+        if (this->heldButton == Button::NO_BUTTON) {
+            return;
+        }
+
+        // Repeat the held direction, stopping at either end
+        this->holdTime += dt;
+        if (this->holdTime < HOLD_DELAY + REPEAT_TIME) {
+            return;
+        }
+        long repeats = (this->holdTime - HOLD_DELAY) / REPEAT_TIME;
+        this->holdTime -= repeats * REPEAT_TIME;
+        if (!this->moveRows(this->buttonRows(this->heldButton) * repeats)) {
+            this->heldButton = Button::NO_BUTTON;
+        }
+    }
+
+    bool VirtualList::isAnimating() {
+        if (this->isVisible() && (this->heldButton != Button::NO_BUTTON || this->isTouched)) {
+            return true;
+        }
+        return Element::isAnimating();
+    }
+
+    VirtualList::~VirtualList() {
+        this->removeAllElements();
+    }
+};
\ No newline at end of file
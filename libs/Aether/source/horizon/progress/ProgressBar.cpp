@@ -4,22 +4,22 @@ namespace Aether {
     ProgressBar::ProgressBar(int x, int y, int w) : BaseProgress(x, y, w, 16) {
         this->boxTex = new Box(this->x(), this->y(), this->w(), this->h(), 1);
         this->addElement(this->boxTex);
-        this->progressTex = new Rectangle(this->x() + 3, this->y() + 3, this->w() - 6, this->h() - 6);
+        this->progressTex = new Rectangle(this->x() + 3, this->y() + 3, 0, this->h() - 6);
         this->addElement(this->progressTex);
     }
 
     void ProgressBar::redrawBar() {
         this->boxTex->setBoxSize(this->w(), this->h());
-        this->progressTex->setRectSize(this->w(), this->h());
+        this->progressTex->setRectSize((this->w() - 6) * (this->value()/100.0), this->h() - 6);
     }
 
     void ProgressBar::setValue(float f) {
         float old = this->value();
         BaseProgress::setValue(f);
 
+        // Only the drawn width changes (no texture to regenerate)
         if (old != this->value()) {
-            this->progressTex->setW(this->progressTex->texW() * (this->value()/100.0));
-            this->progressTex->setMask(0, 0, this->progressTex->texW() * (this->value()/100.0), this->progressTex->texH());
+            this->progressTex->setW((this->w() - 6) * (this->value()/100.0));
         }
     }
 
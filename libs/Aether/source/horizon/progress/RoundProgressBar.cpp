@@ -5,24 +5,24 @@ namespace Aether {
         // Render textures
         this->backTex = new Rectangle(this->x(), this->y(), this->w(), this->h(), (this->h()/2) - 1);
         this->addElement(this->backTex);
-        this->progressTex = new Rectangle(this->x(), this->y(), this->w(), this->h(), (this->h()/2) - 1);
-        this->progressTex->setW(this->progressTex->texW() * (this->value()/100.0));
-        this->progressTex->setMask(0, 0, this->progressTex->texW() * (this->value()/100.0), this->progressTex->texH());
+        this->progressTex = new Rectangle(this->x(), this->y(), this->w() * (this->value()/100.0), this->h(), (this->h()/2) - 1);
         this->addElement(this->progressTex);
     }
 
     void RoundProgressBar::redrawBar() {
         this->backTex->setRectSize(this->w(), this->h());
-        this->progressTex->setRectSize(this->w(), this->h());
+        this->backTex->setCornerRadius((this->h()/2) - 1);
+        this->progressTex->setRectSize(this->w() * (this->value()/100.0), this->h());
+        this->progressTex->setCornerRadius((this->h()/2) - 1);
     }
 
     void RoundProgressBar::setValue(float f) {
         float old = this->value();
         BaseProgress::setValue(f);
 
+        // Only the drawn width changes (no texture to regenerate)
         if (old != this->value()) {
-            this->progressTex->setW(this->progressTex->texW() * (this->value()/100.0));
-            this->progressTex->setMask(0, 0, this->progressTex->texW() * (this->value()/100.0), this->progressTex->texH());
+            this->progressTex->setW(this->w() * (this->value()/100.0));
         }
     }
 
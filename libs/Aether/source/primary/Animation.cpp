@@ -25,6 +25,13 @@ namespace Aether {
         }
     }
 
+    bool Animation::isAnimating() {
+        if (this->isVisible() && !this->paused && this->children.size() > 1) {
+            return true;
+        }
+        return Element::isAnimating();
+    }
+
     void Animation::render() {
         // Do nothing if hidden or off-screen
         if (!this->isVisible()) {
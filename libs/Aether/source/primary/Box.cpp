@@ -5,16 +5,11 @@ namespace Aether {
         Texture::setW(w);
         Texture::setH(h);
         this->cornerRadius_ = r;
-        this->setBorder(b);
+        this->border_ = b;
     }
 
     void Box::generateSurface() {
-        // This is safe - see Texture::regenerate()
-        if (this->cornerRadius_ > 0) {
-            this->texture = SDLHelper::renderRoundRect(this->w(), this->h(), this->cornerRadius_, this->border());
-        } else {
-            this->texture = SDLHelper::renderRect(this->w(), this->h(), this->border());
-        }
+        // Nothing to generate, render() draws the box from cached slices
     }
 
     unsigned int Box::border() {
@@ -23,13 +18,12 @@ namespace Aether {
 
     void Box::setBorder(unsigned int b) {
         this->border_ = b;
-        this->regenerate();
+        this->invalidate();
     }
 
     void Box::setBoxSize(int w, int h) {
         Texture::setW(w);
         Texture::setH(h);
-        this->regenerate();
     }
 
     unsigned int Box::cornerRadius() {
@@ -38,6 +32,15 @@ namespace Aether {
 
     void Box::setCornerRadius(unsigned int r) {
         this->cornerRadius_ = r;
-        this->regenerate();
+        this->invalidate();
+    }
+
+    void Box::render() {
+        if (this->hidden() || this->border_ == 0) {
+            return;
+        }
+
+        SDLHelper::drawSlicedRect(this->colour, this->x(), this->y(), this->w(), this->h(), this->cornerRadius_, this->border_);
+        Element::render();
     }
 };
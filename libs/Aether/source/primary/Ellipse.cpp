@@ -4,12 +4,11 @@ namespace Aether {
     Ellipse::Ellipse(int x, int y, unsigned int xd, unsigned int yd) : Texture(x, y, RenderType::OnCreate) {
         this->xDiameter_ = xd;
         this->yDiameter_ = ((yd == 0) ? xd : yd);
-        this->regenerate();
+        Texture::setWH(this->xDiameter_ + 4, this->yDiameter_ + 4);
     }
 
     void Ellipse::generateSurface() {
-        // This is safe - see Texture::regenerate()
-        this->texture = SDLHelper::renderEllipse(this->xDiameter_, this->yDiameter_);
+        // Nothing to generate, render() draws the ellipse as a mesh
     }
 
     unsigned int Ellipse::xDiameter() {
@@ -18,7 +17,7 @@ namespace Aether {
 
     void Ellipse::setXDiameter(unsigned int xd) {
         this->xDiameter_ = xd;
-        this->regenerate();
+        Texture::setW(this->xDiameter_ + 4);
     }
 
     unsigned int Ellipse::yDiameter() {
@@ -27,7 +26,7 @@ namespace Aether {
 
     void Ellipse::setYDiameter(unsigned int yd) {
         this->yDiameter_ = yd;
-        this->regenerate();
+        Texture::setH(this->yDiameter_ + 4);
     }
 
     void Ellipse::renderHighlighted() {
@@ -44,4 +43,13 @@ namespace Aether {
     void Ellipse::renderSelected() {
         SDLHelper::drawEllipse(this->hiSel, this->x() + this->w()/2, this->y() + this->h()/2, this->w(), this->h());
     }
-};
\ No newline at end of file
+
+    void Ellipse::render() {
+        if (this->hidden()) {
+            return;
+        }
+
+        SDLHelper::drawEllipse(this->colour, this->x() + this->xDiameter_/2 + 2, this->y() + this->yDiameter_/2 + 2, this->xDiameter_, this->yDiameter_);
+        Element::render();
+    }
+};
@@ -4,16 +4,11 @@ namespace Aether {
     Rectangle::Rectangle(int x, int y, int w, int h, unsigned int r) : Texture(x, y, RenderType::OnCreate) {
         Texture::setW(w);
         Texture::setH(h);
-        this->setCornerRadius(r);
+        this->cornerRadius_ = r;
     }
 
     void Rectangle::generateSurface() {
-        // This is safe - see Texture::regenerate()
-        if (this->cornerRadius_ > 0) {
-            this->texture = SDLHelper::renderFilledRoundRect(this->w(), this->h(), this->cornerRadius_);
-        } else {
-            this->texture = SDLHelper::renderFilledRect(this->w(), this->h());
-        }
+        // Nothing to generate, render() draws the rectangle from cached slices
     }
 
     unsigned int Rectangle::cornerRadius() {
@@ -22,12 +17,20 @@ namespace Aether {
 
     void Rectangle::setCornerRadius(unsigned int r) {
         this->cornerRadius_ = r;
-        this->regenerate();
+        this->invalidate();
     }
 
     void Rectangle::setRectSize(int w, int h) {
         Texture::setW(w);
         Texture::setH(h);
-        this->regenerate();
     }
-};
\ No newline at end of file
+
+    void Rectangle::render() {
+        if (this->hidden()) {
+            return;
+        }
+
+        SDLHelper::drawSlicedRect(this->colour, this->x(), this->y(), this->w(), this->h(), this->cornerRadius_);
+        Element::render();
+    }
+};
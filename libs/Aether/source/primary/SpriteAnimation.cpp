@@ -0,0 +1,144 @@
+#include "Aether/primary/SpriteAnimation.hpp"
+
+namespace Aether {
+    SpriteAnimation::SpriteAnimation(int x, int y, std::string p, int fw, int fh, unsigned int n, RenderType t) : Image(x, y, p, 1, 1, t) {
+        this->frameW = fw;
+        this->frameH = fh;
+        this->maxFrames = n;
+        this->customFrames = false;
+        this->idx = 0;
+        this->frameTime = 1000;     // Default of 1 second per frame
+        this->currTime = 0;
+        this->paused = false;
+
+        // Sheet is already loaded if rendered on creation
+        if (this->textureReady()) {
+            this->sliceSheet();
+        }
+    }
+
+    SpriteAnimation::SpriteAnimation(int x, int y, u8 * p, size_t s, int fw, int fh, unsigned int n, RenderType t) : Image(x, y, p, s, 1, 1, t) {
+        this->frameW = fw;
+        this->frameH = fh;
+        this->maxFrames = n;
+        this->customFrames = false;
+        this->idx = 0;
+        this->frameTime = 1000;     // Default of 1 second per frame
+        this->currTime = 0;
+        this->paused = false;
+
+        // Sheet is already loaded if rendered on creation
+        if (this->textureReady()) {
+            this->sliceSheet();
+        }
+    }
+
+    void SpriteAnimation::sliceSheet() {
+        if (!this->customFrames) {
+            this->frames.clear();
+            if (this->frameW > 0 && this->frameH > 0) {
+                int cols = this->texW() / this->frameW;
+                int rows = this->texH() / this->frameH;
+                for (int r = 0; r < rows; r++) {
+                    for (int c = 0; c < cols; c++) {
+                        if (this->maxFrames > 0 && this->frames.size() >= this->maxFrames) {
+                            break;
+                        }
+                        this->frames.push_back(SDL_Rect{c * this->frameW, r * this->frameH, this->frameW, this->frameH});
+                    }
+                }
+            }
+        }
+
+        if (this->idx >= this->frames.size()) {
+            this->idx = 0;
+        }
+
+        // Size to the first frame (converting the sheet resets size to the whole texture)
+        if (!this->frames.empty()) {
+            this->setWH(this->frames[0].w, this->frames[0].h);
+        }
+        this->showFrame();
+    }
+
+    void SpriteAnimation::showFrame() {
+        if (this->idx < this->frames.size()) {
+            const SDL_Rect & r = this->frames[this->idx];
+            this->setMask(r.x, r.y, r.w, r.h);
+        }
+    }
+
+    void SpriteAnimation::setFrames(std::vector<SDL_Rect> f) {
+        this->frames = f;
+        this->customFrames = true;
+        this->sliceSheet();
+    }
+
+    unsigned int SpriteAnimation::frameCount() {
+        return this->frames.size();
+    }
+
+    void SpriteAnimation::update(uint32_t dt) {
+        // Slice once the sheet has been converted to a texture
+        bool converting = this->surfaceReady();
+        Image::update(dt);
+        if (converting) {
+            this->sliceSheet();
+        }
+
+        // Increment time and change frame if need be
+        if (!this->paused && this->frames.size() > 1) {
+            unsigned int old = this->idx;
+            this->currTime += dt;
+            while (this->currTime >= this->frameTime) {
+                this->currTime -= this->frameTime;
+                this->idx++;
+                if (this->idx >= this->frames.size()) {
+                    this->idx = 0;
+                }
+            }
+
+            if (this->idx != old) {
+                this->showFrame();
+            }
+        }
+    }
+
+    bool SpriteAnimation::isAnimating() {
+        if (this->isVisible() && !this->paused && this->frames.size() > 1) {
+            return true;
+        }
+        return Image::isAnimating();
+    }
+
+    void SpriteAnimation::pause() {
+        this->paused = true;
+    }
+
+    void SpriteAnimation::resume() {
+        this->paused = false;
+    }
+
+    bool SpriteAnimation::isPaused() {
+        return this->paused;
+    }
+
+    void SpriteAnimation::setAnimateSpeed(int t) {
+        this->frameTime = t;
+    }
+
+    unsigned int SpriteAnimation::animateSpeed() {
+        return this->frameTime;
+    }
+
+    bool SpriteAnimation::setFrameIndex(unsigned int i) {
+        if (i < this->frames.size()) {
+            this->currTime = 0;
+            this->idx = i;
+            this->showFrame();
+            return true;
+        }
+
+        return false;
+    }
+};
@@ -0,0 +1,216 @@
+#include <algorithm>
+#include "Aether/primary/StreamAnimation.hpp"
+#include "Aether/ThreadPool.hpp"
+
+namespace Aether {
+    StreamAnimation::StreamAnimation(int x, int y, int w, int h, unsigned int n, DecodeFunc f, unsigned int r) : Element(x, y, w, h) {
+        this->shared = std::make_shared<Shared>();
+        this->shared->decode = f;
+        this->shared->cancelled = false;
+        this->shared->slots.resize(std::max(r, 2u), Slot{0, SlotStatus::Empty, nullptr, nullptr});
+        this->frames = n;
+        this->step = 0;
+        this->frameTime = 1000;     // Default of 1 second per frame
+        this->currTime = 0;
+        this->paused = false;
+
+        // Start decoding straight away
+        std::lock_guard<std::mutex> lock(this->shared->mutex);
+        this->fillRing();
+    }
+
+    StreamAnimation::StreamAnimation(int x, int y, int w, int h, std::vector<std::string> p, unsigned int r) : StreamAnimation(x, y, w, h, p.size(), [p](unsigned int i) {
+        return SDLHelper::renderImageS(p[i]);
+    }, r) {
+
+    }
+
+    void StreamAnimation::queueStep(unsigned int s) {
+        Slot & slot = this->shared->slots[s % this->shared->slots.size()];
+        slot.step = s;
+        slot.status = SlotStatus::Decoding;
+
+        // Task holds a reference to the shared state so it can always hand back (or free) the surface
+        std::shared_ptr<Shared> sh = this->shared;
+        unsigned int frame = s % this->frames;
+        ThreadPool::addTask([sh, s, frame]() {
+            SDL_Surface * surf = sh->decode(frame);
+
+            std::lock_guard<std::mutex> lock(sh->mutex);
+            Slot & slot = sh->slots[s % sh->slots.size()];
+            if (sh->cancelled) {
+                SDLHelper::freeSurface(surf);
+                return;
+            }
+            slot.surface = surf;
+            slot.status = SlotStatus::Decoded;
+        });
+    }
+
+    void StreamAnimation::fillRing() {
+        if (this->frames == 0) {
+            return;
+        }
+
+        // Keep the current frame and the ones after it (no point decoding a frame twice)
+        unsigned int ahead = std::min(static_cast<unsigned int>(this->shared->slots.size()), this->frames);
+        for (unsigned int i = 0; i < ahead; i++) {
+            unsigned int s = this->step + i;
+            Slot & slot = this->shared->slots[s % this->shared->slots.size()];
+
+            // Slot holds an old step - reuse it once it's not being written to
+            if (slot.step != s || slot.status == SlotStatus::Empty) {
+                if (slot.status == SlotStatus::Decoding) {
+                    continue;
+                }
+                if (slot.status == SlotStatus::Decoded) {
+                    SDLHelper::freeSurface(slot.surface);
+                    slot.surface = nullptr;
+                }
+                this->queueStep(s);
+
+            // Upload once decoded, reusing the slot's texture where possible
+            } else if (slot.status == SlotStatus::Decoded) {
+                if (slot.surface == nullptr) {
+                    slot.status = SlotStatus::Failed;
+                    continue;
+                }
+
+                if (slot.texture != nullptr) {
+                    int w, h;
+                    SDLHelper::getDimensions(slot.texture, &w, &h);
+                    if (w != slot.surface->w || h != slot.surface->h) {
+                        SDLHelper::destroyTexture(slot.texture);
+                        slot.texture = nullptr;
+                    }
+                }
+                if (slot.texture == nullptr) {
+                    slot.texture = SDLHelper::createStreamingTexture(slot.surface->w, slot.surface->h);
+                }
+
+                bool ok = SDLHelper::updateTexture(slot.texture, slot.surface);
+                slot.surface = nullptr;
+                slot.status = (ok ? SlotStatus::Ready : SlotStatus::Failed);
+            }
+        }
+    }
+
+    unsigned int StreamAnimation::frameCount() {
+        return this->frames;
+    }
+
+    unsigned int StreamAnimation::frameIndex() {
+        return (this->frames == 0 ? 0 : this->step % this->frames);
+    }
+
+    void StreamAnimation::update(uint32_t dt) {
+        Element::update(dt);
+
+        std::lock_guard<std::mutex> lock(this->shared->mutex);
+        this->fillRing();
+
+        // Increment time and change frame if need be (holding the frame if the next isn't ready)
+        if (!this->paused && this->frames > 1) {
+            bool changed = false;
+            this->currTime += dt;
+            while (this->currTime >= this->frameTime) {
+                Slot & next = this->shared->slots[(this->step + 1) % this->shared->slots.size()];
+                if (next.step != this->step + 1 || (next.status != SlotStatus::Ready && next.status != SlotStatus::Failed)) {
+                    this->currTime = this->frameTime;
+                    break;
+                }
+
+                this->currTime -= this->frameTime;
+                this->step++;
+                changed = true;
+            }
+
+            // Queue the frames which are now needed
+            if (changed) {
+                this->fillRing();
+            }
+        }
+    }
+
+    bool StreamAnimation::isAnimating() {
+        if (this->isVisible() && !this->paused && this->frames > 1) {
+            return true;
+        }
+
+        std::lock_guard<std::mutex> lock(this->shared->mutex);
+        for (size_t i = 0; i < this->shared->slots.size(); i++) {
+            SlotStatus st = this->shared->slots[i].status;
+            if (st == SlotStatus::Decoding || st == SlotStatus::Decoded) {
+                return true;
+            }
+        }
+        return Element::isAnimating();
+    }
+
+    void StreamAnimation::render() {
+        // Do nothing if hidden or off-screen
+        if (!this->isVisible()) {
+            return;
+        }
+
+        // Draw current frame (nothing until the first one is decoded)
+        const Slot & slot = this->shared->slots[this->step % this->shared->slots.size()];
+        if (slot.step == this->step && slot.status == SlotStatus::Ready) {
+            SDL_BlendMode bld = SDLHelper::getBlendMode();
+            SDLHelper::setBlendMode(SDL_BLENDMODE_BLEND);
+            SDLHelper::drawTexture(slot.texture, Colour{255, 255, 255, 255}, this->x(), this->y(), this->w(), this->h());
+            SDLHelper::setBlendMode(bld);
+        }
+
+        Element::render();
+    }
+
+    void StreamAnimation::pause() {
+        this->paused = true;
+    }
+
+    void StreamAnimation::resume() {
+        this->paused = false;
+    }
+
+    bool StreamAnimation::isPaused() {
+        return this->paused;
+    }
+
+    void StreamAnimation::setAnimateSpeed(int t) {
+        this->frameTime = t;
+    }
+
+    unsigned int StreamAnimation::animateSpeed() {
+        return this->frameTime;
+    }
+
+    bool StreamAnimation::setFrameIndex(unsigned int i) {
+        if (i < this->frames) {
+            std::lock_guard<std::mutex> lock(this->shared->mutex);
+            this->currTime = 0;
+            this->step = i;
+            this->fillRing();
+            return true;
+        }
+
+        return false;
+    }
+
+    StreamAnimation::~StreamAnimation() {
+        std::lock_guard<std::mutex> lock(this->shared->mutex);
+        this->shared->cancelled = true;
+        for (size_t i = 0; i < this->shared->slots.size(); i++) {
+            Slot & slot = this->shared->slots[i];
+            if (slot.status == SlotStatus::Decoded) {
+                SDLHelper::freeSurface(slot.surface);
+            }
+            if (slot.texture != nullptr) {
+                SDLHelper::destroyTexture(slot.texture);
+            }
+            slot.surface = nullptr;
+            slot.texture = nullptr;
+            slot.status = SlotStatus::Empty;
+        }
+    }
+};
@@ -14,35 +14,46 @@ namespace Aether {
         if (this->renderType == RenderType::OnCreate) {
             this->generateSurface();
             this->convertSurface();
+        } else {
+            this->measure();
         }
 
         this->setScroll(this->scroll_);
     }
 
-    void Text::generateSurface() {
-        int style;
-        switch (this->fontStyle) {
-            case FontStyle::Regular:
-                style = TTF_STYLE_NORMAL;
-                break;
-
+    // Convert font style to SDL_ttf's style
+    static int toTTFStyle(FontStyle f) {
+        switch (f) {
             case FontStyle::Bold:
-                style = TTF_STYLE_BOLD;
-                break;
+                return TTF_STYLE_BOLD;
 
             case FontStyle::Italic:
-                style = TTF_STYLE_ITALIC;
-                break;
+                return TTF_STYLE_ITALIC;
 
             case FontStyle::Underline:
-                style = TTF_STYLE_UNDERLINE;
-                break;
+                return TTF_STYLE_UNDERLINE;
 
             case FontStyle::Strikethrough:
-                style = TTF_STYLE_STRIKETHROUGH;
-                break;
+                return TTF_STYLE_STRIKETHROUGH;
+
+            default:
+                return TTF_STYLE_NORMAL;
         }
-        this->surface = SDLHelper::renderTextS(this->string_, this->fontSize_, style);
+    }
+
+    void Text::generateSurface() {
+        this->surface = SDLHelper::renderTextS(this->string_, this->fontSize_, toTTFStyle(this->fontStyle));
+    }
+
+    void Text::measure() {
+        // Rendered texture sets the size, so only needed until there is one
+        if (this->renderType == RenderType::OnCreate || this->textureReady()) {
+            return;
+        }
+
+        int w, h;
+        SDLHelper::getTextDimensions(this->string_, this->fontSize_, &w, &h, toTTFStyle(this->fontStyle));
+        this->setWH(w, h);
     }
 
     bool Text::scroll() {
@@ -65,11 +76,13 @@ namespace Aether {
 
     void Text::setFontSize(unsigned int s) {
         BaseText::setFontSize(s);
+        this->measure();
         this->setScroll(this->scroll_);
     }
 
     void Text::setString(std::string s) {
         BaseText::setString(s);
+        this->measure();
         this->setScroll(this->scroll_);
     }
 
@@ -103,6 +116,13 @@ namespace Aether {
         }
     }
 
+    bool Text::isAnimating() {
+        if (this->isVisible() && this->scroll() && this->texW() > this->w()) {
+            return true;
+        }
+        return BaseText::isAnimating();
+    }
+
     void Text::setW(int w) {
         BaseText::setW(w);
         this->setScroll(this->scroll_);
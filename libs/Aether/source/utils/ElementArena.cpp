@@ -0,0 +1,107 @@
+#include "Aether/utils/ElementArena.hpp"
+#include <cstdlib>
+
+// Default size of each block (in bytes)
+#define DEFAULT_BLOCK_SIZE (64 * 1024)
+// Alignment of each allocation
+#define ALIGNMENT alignof(std::max_align_t)
+
+namespace Aether {
+    thread_local ElementArena * ElementArena::active_ = nullptr;
+
+    ElementArena::ElementArena(size_t size) {
+        this->blockSize = (size == 0 ? DEFAULT_BLOCK_SIZE : size);
+        this->block = 0;
+        this->used = 0;
+        this->live = 0;
+        this->prev = nullptr;
+    }
+
+    void ElementArena::begin() {
+        this->prev = active_;
+        active_ = this;
+    }
+
+    void ElementArena::end() {
+        if (active_ == this) {
+            active_ = this->prev;
+        }
+        this->prev = nullptr;
+    }
+
+    void ElementArena::rewind() {
+        for (size_t i = 0; i < this->large.size(); i++) {
+            std::free(this->large[i]);
+        }
+        this->large.clear();
+        this->block = 0;
+        this->used = 0;
+    }
+
+    void * ElementArena::allocate(size_t n) {
+        n = (n + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+
+        // Anything larger than a block gets its own allocation
+        if (n > this->blockSize) {
+            char * big = static_cast<char *>(std::malloc(n));
+            if (big == nullptr) {
+                return nullptr;
+            }
+            this->large.push_back(big);
+            this->live++;
+            return big;
+        }
+
+        // Move to the next block (allocating if needed) once this one is full
+        if (this->blocks.empty() || this->used + n > this->blockSize) {
+            size_t next = (this->blocks.empty() ? 0 : this->block + 1);
+            if (next >= this->blocks.size()) {
+                char * b = static_cast<char *>(std::malloc(this->blockSize));
+                if (b == nullptr) {
+                    return nullptr;
+                }
+                this->blocks.push_back(b);
+            }
+            this->block = next;
+            this->used = 0;
+        }
+
+        char * p = this->blocks[this->block] + this->used;
+        this->used += n;
+        this->live++;
+        return p;
+    }
+
+    void ElementArena::release() {
+        if (this->live > 0) {
+            this->live--;
+            if (this->live == 0) {
+                this->rewind();
+            }
+        }
+    }
+
+    size_t ElementArena::liveCount() {
+        return this->live;
+    }
+
+    ElementArena * ElementArena::active() {
+        return active_;
+    }
+
+    ElementArena::Scope::Scope(ElementArena & a) : arena(a) {
+        this->arena.begin();
+    }
+
+    ElementArena::Scope::~Scope() {
+        this->arena.end();
+    }
+
+    ElementArena::~ElementArena() {
+        this->end();
+        this->rewind();
+        for (size_t i = 0; i < this->blocks.size(); i++) {
+            std::free(this->blocks[i]);
+        }
+    }
+};
@@ -1,7 +1,9 @@
+#include <algorithm>
 #include <atomic>
+#include <cmath>
 #include <mutex>
 #include "Aether/utils/SDLHelper.hpp"
-#include <SDL2/SDL2_gfxPrimitives.h>
+#include "Aether/utils/Trace.hpp"
 #include <SDL2/SDL2_rotozoom.h>
 #include <SDL2/SDL_image.h>
 #include <unordered_map>
@@ -24,6 +26,29 @@ static std::unordered_map<int, TTF_Font *> fontCache[PlSharedFontType_Total];
 static bool customFont;
 static std::string customFontPath;
 
+// === SHAPES ===
+// Approximate length of each edge in a curve (in pixels)
+#define MESH_SEGMENT_LENGTH 3.0f
+// Maximum number of cached meshes (cache is emptied when exceeded as sizes can change every frame)
+#define MESH_CACHE_MAX 64
+// Shapes which are tessellated
+enum class MeshShape {
+    Ellipse,
+    FilledRoundRect,
+    RoundRect
+};
+// Triangles for a shape at the origin (vertex alpha is the coverage, colour is applied when drawn)
+struct Mesh {
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+};
+// Tessellated shapes, keyed by shape, size, radius and border
+static std::unordered_map<uint64_t, Mesh> meshCache;
+// Reused vertices which are offset/coloured for drawing
+static std::vector<SDL_Vertex> meshScratch;
+// Nine-slice textures for rounded rectangles, keyed by radius and border
+static std::unordered_map<uint64_t, SDL_Texture *> sliceCache;
+
 // === MISCELLANEOUS ===
 // Offset position
 static int offsetX;
@@ -74,12 +99,53 @@ static uint16_t getUTF8Char(std::string str, unsigned int & pos) {
     return c;
 }
 
+// Returns the font of the given type and size, loading the shared font and opening it on first use
+// (index 0 is used for a custom font). The font cache mutex must be held!
+static TTF_Font * getFont(int i, int font_size) {
+    std::unordered_map<int, TTF_Font *>::iterator it = fontCache[i].find(font_size);
+    if (it != fontCache[i].end()) {
+        return it->second;
+    }
+
+    TTF_Font * font;
+    if (customFont) {
+        font = TTF_OpenFont(customFontPath.c_str(), font_size);
+    } else {
+        if (fontData[i].address == nullptr) {
+            // Use the standard font for now if this one can't be fetched (it is tried again next time)
+            if (!R_SUCCEEDED(plGetSharedFontByType(&fontData[i], (PlSharedFontType)i))) {
+                fontData[i].address = nullptr;
+                return (i == 0 ? nullptr : getFont(0, font_size));
+            }
+        }
+        font = TTF_OpenFontRW(SDL_RWFromMem(fontData[i].address, fontData[i].size), 1, font_size);
+    }
+    // Failures aren't cached so they are tried again next time
+    if (font != nullptr) {
+        fontCache[i][font_size] = font;
+    }
+    return font;
+}
+
+// Returns the first font which provides the glyph, or the standard font if none do (nullptr if
+// no font could be opened). The font cache mutex must be held!
+static TTF_Font * getGlyphFont(uint16_t ch, int font_size) {
+    for (int i = 0; i < PlSharedFontType_Total; i++) {
+        TTF_Font * font = getFont(i, font_size);
+        if (font != nullptr && TTF_GlyphIsProvided(font, ch)) {
+            return font;
+        }
+    }
+    return getFont(0, font_size);
+}
+
 namespace SDLHelper {
     bool initSDL() {
-        // Init main SDL
-        if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_JOYSTICK) < 0) {
+        // Init main SDL (joystick is done after the first frame)
+        if (SDL_Init(SDL_INIT_VIDEO) < 0) {
             return false;
         }
+        Aether::Trace::mark("SDL video initialized");
 
         // Initialize SDL_ttf
         if (TTF_Init() == -1) {
@@ -97,11 +163,7 @@ namespace SDLHelper {
         if (!renderer) {
             return false;
         }
-
-        // Prepare controller (only railed for now)
-        if (SDL_JoystickOpen(0) == NULL) {
-            return false;
-        }
+        Aether::Trace::mark("Window + renderer created");
 
         // Set up blending
         SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
@@ -112,15 +174,29 @@ namespace SDLHelper {
         offsetX = 0;
         offsetY = 0;
 
-        // Load fonts
+        // Prepare fonts (shared fonts are only loaded when a glyph needs them)
         customFont = false;
         Result rc = plInitialize(PlServiceType_User);
         if (!R_SUCCEEDED(rc)) {
             return false;
         }
         for (int i = 0; i < PlSharedFontType_Total; i++) {
-            plGetSharedFontByType(&fontData[i], (PlSharedFontType)i);
+            fontData[i].address = nullptr;
         }
+        Aether::Trace::mark("Font service initialized");
+        return true;
+    }
+
+    bool initJoystick() {
+        if (SDL_InitSubSystem(SDL_INIT_JOYSTICK) < 0) {
+            return false;
+        }
+
+        // Prepare controller (only railed for now)
+        if (SDL_JoystickOpen(0) == NULL) {
+            return false;
+        }
+        Aether::Trace::mark("Joystick opened");
         return true;
     }
 
@@ -129,6 +205,12 @@ namespace SDLHelper {
         emptyFontCache();
         plExit();
 
+        // Delete shape slices
+        for (std::unordered_map<uint64_t, SDL_Texture *>::iterator it = sliceCache.begin(); it != sliceCache.end(); it++) {
+            destroyTexture(it->second);
+        }
+        sliceCache.clear();
+
         SDL_DestroyRenderer(renderer);
         SDL_DestroyWindow(window);
         TTF_Quit();
@@ -179,6 +261,31 @@ namespace SDLHelper {
         return t;
     }
 
+    SDL_Texture * createStreamingTexture(int w, int h) {
+        SDL_Texture * t = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STREAMING, w, h);
+
+        // Increment counters
+        if (t != NULL) {
+            texNum++;
+            memUsage += (w * h * 4);    // 4 bytes per pixel
+        }
+
+        return t;
+    }
+
+    bool updateTexture(SDL_Texture * t, SDL_Surface * s) {
+        if (t == nullptr || s == nullptr) {
+            freeSurface(s);
+            return false;
+        }
+
+        int w, h;
+        SDL_QueryTexture(t, nullptr, nullptr, &w, &h);
+        bool ok = (w == s->w && h == s->h && SDL_UpdateTexture(t, nullptr, s->pixels, s->pitch) == 0);
+        freeSurface(s);
+        return ok;
+    }
+
     void destroyTexture(SDL_Texture * t) {
         // Decrease counters
         if (t != NULL) {
@@ -247,6 +354,14 @@ namespace SDLHelper {
         SDL_RenderClear(renderer);
     }
 
+    SDL_Texture * getRenderTarget() {
+        return SDL_GetRenderTarget(renderer);
+    }
+
+    void setRenderTarget(SDL_Texture * t) {
+        SDL_SetRenderTarget(renderer, t);
+    }
+
     SDL_BlendMode getBlendMode() {
         return tex_blend_mode;
     }
@@ -265,9 +380,148 @@ namespace SDLHelper {
         SDL_RenderPresent(renderer);
     }
 
+    // Returns the number of segments to approximate a quarter of a curve with the given radius
+    static int quarterSegments(float r) {
+        int n = std::ceil((r * M_PI/2) / MESH_SEGMENT_LENGTH);
+        return std::max(1, std::min(n, 32));
+    }
+
+    // Adds points (and outward normals) around a rounded rectangle, clockwise from the top right corner
+    static void roundRectContour(float x0, float y0, float x1, float y1, float r, int seg, std::vector<SDL_FPoint> & pts, std::vector<SDL_FPoint> & nrm) {
+        const float cx[4] = {x1 - r, x1 - r, x0 + r, x0 + r};
+        const float cy[4] = {y0 + r, y1 - r, y1 - r, y0 + r};
+        for (int corner = 0; corner < 4; corner++) {
+            float start = (corner - 1) * M_PI/2;
+            for (int i = 0; i <= seg; i++) {
+                float a = start + (i * M_PI/2)/seg;
+                SDL_FPoint n = {std::cos(a), std::sin(a)};
+                pts.push_back(SDL_FPoint{cx[corner] + r*n.x, cy[corner] + r*n.y});
+                nrm.push_back(n);
+            }
+        }
+    }
+
+    // Adds a vertex with the given coverage (alpha) to a mesh
+    static void addVertex(Mesh & m, float x, float y, uint8_t a) {
+        m.vertices.push_back(SDL_Vertex{SDL_FPoint{x, y}, SDL_Color{255, 255, 255, a}, SDL_FPoint{0, 0}});
+    }
+
+    // Adds the two triangles of a quad to a mesh
+    static void addQuad(Mesh & m, int a, int b, int c, int d) {
+        int q[6] = {a, b, c, a, c, d};
+        m.indices.insert(m.indices.end(), q, q + 6);
+    }
+
+    // Fills a convex contour as a fan from the centre, with a one pixel fringe fading out at the edge (anti-aliasing)
+    static void buildFill(Mesh & m, float cx, float cy, const std::vector<SDL_FPoint> & pts, const std::vector<SDL_FPoint> & nrm) {
+        addVertex(m, cx, cy, 255);
+        for (size_t i = 0; i < pts.size(); i++) {
+            addVertex(m, pts[i].x - 0.5f*nrm[i].x, pts[i].y - 0.5f*nrm[i].y, 255);
+            addVertex(m, pts[i].x + 0.5f*nrm[i].x, pts[i].y + 0.5f*nrm[i].y, 0);
+        }
+
+        int n = pts.size();
+        for (int i = 0; i < n; i++) {
+            int in = 1 + 2*i;
+            int next = 1 + 2*((i + 1) % n);
+            m.indices.push_back(0);
+            m.indices.push_back(in);
+            m.indices.push_back(next);
+            addQuad(m, in, in + 1, next + 1, next);
+        }
+    }
+
+    // Fills the band between two contours (with the same number of points), with a fringe on both edges
+    static void buildRing(Mesh & m, const std::vector<SDL_FPoint> & outer, const std::vector<SDL_FPoint> & outerN, const std::vector<SDL_FPoint> & inner, const std::vector<SDL_FPoint> & innerN) {
+        for (size_t i = 0; i < outer.size(); i++) {
+            addVertex(m, outer[i].x + 0.5f*outerN[i].x, outer[i].y + 0.5f*outerN[i].y, 0);
+            addVertex(m, outer[i].x - 0.5f*outerN[i].x, outer[i].y - 0.5f*outerN[i].y, 255);
+            addVertex(m, inner[i].x + 0.5f*innerN[i].x, inner[i].y + 0.5f*innerN[i].y, 255);
+            addVertex(m, inner[i].x - 0.5f*innerN[i].x, inner[i].y - 0.5f*innerN[i].y, 0);
+        }
+
+        int n = outer.size();
+        for (int i = 0; i < n; i++) {
+            int v = 4*i;
+            int next = 4*((i + 1) % n);
+            for (int band = 0; band < 3; band++) {
+                addQuad(m, v + band, next + band, next + band + 1, v + band + 1);
+            }
+        }
+    }
+
+    // Returns the (cached) mesh for a shape covering (0, 0) to (w, h)
+    static const Mesh & getMesh(MeshShape s, int w, int h, unsigned int r, unsigned int b) {
+        uint64_t key = (static_cast<uint64_t>(s) << 60) | ((static_cast<uint64_t>(w) & 0xFFFFF) << 40) | ((static_cast<uint64_t>(h) & 0xFFFFF) << 20) | ((r & 0x3FF) << 10) | (b & 0x3FF);
+        std::unordered_map<uint64_t, Mesh>::iterator it = meshCache.find(key);
+        if (it != meshCache.end()) {
+            return it->second;
+        }
+
+        if (meshCache.size() >= MESH_CACHE_MAX) {
+            meshCache.clear();
+        }
+        Mesh & m = meshCache[key];
+
+        // Radius can't be larger than the shape
+        float rad = std::min(static_cast<float>(r), std::min(w, h)/2.0f);
+        std::vector<SDL_FPoint> pts, nrm;
+        switch (s) {
+            case MeshShape::Ellipse: {
+                float rx = w/2.0f;
+                float ry = h/2.0f;
+                int seg = 4 * quarterSegments(std::max(rx, ry));
+                for (int i = 0; i < seg; i++) {
+                    float a = (i * 2 * M_PI)/seg;
+                    float nx = std::cos(a) * ry;
+                    float ny = std::sin(a) * rx;
+                    float len = std::sqrt(nx*nx + ny*ny);
+                    pts.push_back(SDL_FPoint{rx + rx*std::cos(a), ry + ry*std::sin(a)});
+                    nrm.push_back((len > 0 ? SDL_FPoint{nx/len, ny/len} : SDL_FPoint{0, 0}));
+                }
+                buildFill(m, rx, ry, pts, nrm);
+                break;
+            }
+
+            case MeshShape::FilledRoundRect:
+                roundRectContour(0, 0, w, h, rad, quarterSegments(rad), pts, nrm);
+                buildFill(m, w/2.0f, h/2.0f, pts, nrm);
+                break;
+
+            case MeshShape::RoundRect: {
+                // Inner edge uses the same number of points so the band can be joined up
+                float bd = std::min(static_cast<float>(b), std::min(w, h)/2.0f);
+                int seg = quarterSegments(rad);
+                std::vector<SDL_FPoint> inner, innerN;
+                roundRectContour(0, 0, w, h, rad, seg, pts, nrm);
+                roundRectContour(bd, bd, w - bd, h - bd, std::max(rad - bd, 0.0f), seg, inner, innerN);
+                buildRing(m, pts, nrm, inner, innerN);
+                break;
+            }
+        }
+
+        return m;
+    }
+
+    // Draws a mesh with the given colour at the given position (one draw call)
+    static void drawMesh(const Mesh & m, SDL_Color c, float x, float y) {
+        meshScratch.resize(m.vertices.size());
+        for (size_t i = 0; i < m.vertices.size(); i++) {
+            const SDL_Vertex & v = m.vertices[i];
+            meshScratch[i].position = SDL_FPoint{v.position.x + x + offsetX, v.position.y + y + offsetY};
+            meshScratch[i].color = SDL_Color{c.r, c.g, c.b, static_cast<uint8_t>((c.a * v.color.a)/255)};
+            meshScratch[i].tex_coord = v.tex_coord;
+        }
+
+        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+        SDL_RenderGeometry(renderer, nullptr, meshScratch.data(), meshScratch.size(), m.indices.data(), m.indices.size());
+    }
+
     void drawEllipse(SDL_Color c, int x, int y, unsigned int w, unsigned int h) {
-        filledEllipseRGBA(renderer, x + offsetX, y + offsetY, w/2, h/2, c.r, c.g, c.b, c.a);
-        aaellipseRGBA(renderer, x + offsetX, y + offsetY, w/2, h/2, c.r, c.g, c.b, c.a);
+        // Centred on (x, y), covering the same pixels as an ellipse with radii (w/2, h/2) always has
+        int rx = w/2;
+        int ry = h/2;
+        drawMesh(getMesh(MeshShape::Ellipse, 2*rx + 1, 2*ry + 1, 0, 0), c, x - rx, y - ry);
     }
 
     void drawFilledRect(SDL_Color c, int x, int y, int w, int h) {
@@ -277,22 +531,112 @@ namespace SDLHelper {
     }
 
     void drawFilledRoundRect(SDL_Color c, int x, int y, int w, int h, unsigned int r) {
-        roundedBoxRGBA(renderer, offsetX + (x + w - 2), offsetY + y, offsetX + x, offsetY + (y + h - 2), r, c.r, c.g, c.b, c.a);
-        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+        if (w <= 1 || h <= 1) {
+            return;
+        }
+        drawMesh(getMesh(MeshShape::FilledRoundRect, w - 1, h - 1, r, 0), c, x, y);
     }
 
     void drawRoundRect(SDL_Color c, int x, int y, int w, int h, unsigned int r, unsigned int b) {
-        for (unsigned int i = 0; i < b; i++) {
-            roundedRectangleRGBA(renderer, (x + offsetX + w) - i, y + offsetY + i, offsetX + x + i, (offsetY + y + h) - i, r, c.r, c.g, c.b, c.a);
+        // Edges are inclusive (matching the outline this used to draw a pixel at a time)
+        if (w < 0 || h < 0 || b == 0) {
+            return;
         }
-        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+        drawMesh(getMesh(MeshShape::RoundRect, w + 1, h + 1, r, b), c, x, y);
+    }
+
+    // Draws a border inside the given rectangle as (up to) four filled rectangles
+    static void fillBorder(SDL_Color c, int x, int y, int w, int h, int b) {
+        if (b <= 0 || w <= 0 || h <= 0) {
+            return;
+        }
+
+        // Border covers everything (avoid overlapping edges)
+        if (2*b >= w || 2*b >= h) {
+            drawFilledRect(c, x, y, w, h);
+            return;
+        }
+
+        SDL_Rect rr[4] = {
+            {x + offsetX, y + offsetY, w, b},
+            {x + offsetX, y + offsetY + h - b, w, b},
+            {x + offsetX, y + offsetY + b, b, h - 2*b},
+            {x + offsetX + w - b, y + offsetY + b, b, h - 2*b}
+        };
+        SDL_SetRenderDrawColor(renderer, c.r, c.g, c.b, c.a);
+        SDL_RenderFillRects(renderer, rr, 4);
     }
 
     void drawRect(SDL_Color c, int x, int y, int w, int h, unsigned int b) {
-        for (unsigned int i = 0; i < b; i++) {
-            rectangleRGBA(renderer, (x + offsetX + w) - i, y + offsetY + i, x + offsetX + i, (y + offsetY + h) - i, c.r, c.g, c.b, c.a);
+        // Edges are inclusive (matching the outline this used to draw a pixel at a time)
+        fillBorder(c, x, y, w + 1, h + 1, b);
+    }
+
+    // Returns the (cached) nine-slice texture for the given radius and border, rendering it if needed
+    static SDL_Texture * getSlice(unsigned int r, unsigned int b) {
+        uint64_t key = (static_cast<uint64_t>(r) << 32) | b;
+        std::unordered_map<uint64_t, SDL_Texture *>::iterator it = sliceCache.find(key);
+        if (it != sliceCache.end()) {
+            return it->second;
+        }
+
+        // Corners with a one pixel row/column between them which is stretched for edges
+        int k = std::max(r, b);
+        int s = 2*k + 1;
+        SDL_Texture * tex = convertSurfaceToTexture(b == 0 ? renderFilledRoundRectS(s, s, r) : renderRoundRectS(s, s, r, b));
+        if (tex == nullptr) {
+            return nullptr;
+        }
+
+        sliceCache[key] = tex;
+        return tex;
+    }
+
+    void drawSlicedRect(SDL_Color c, int x, int y, int w, int h, unsigned int r, unsigned int b) {
+        if (w <= 0 || h <= 0) {
+            return;
+        }
+
+        // Square corners don't need a texture
+        if (r == 0) {
+            if (b == 0) {
+                drawFilledRect(c, x, y, w, h);
+            } else {
+                fillBorder(c, x, y, w, h, b);
+            }
+            return;
+        }
+
+        SDL_Texture * tex = getSlice(r, b);
+        if (tex == nullptr) {
+            return;
+        }
+        SDL_SetTextureColorMod(tex, c.r, c.g, c.b);
+        SDL_SetTextureAlphaMod(tex, c.a);
+        SDL_SetTextureBlendMode(tex, tex_blend_mode);
+
+        // Shrink corners if the shape is smaller than them
+        int k = std::max(r, b);
+        int kx = std::min(k, w/2);
+        int ky = std::min(k, h/2);
+        int sx[3] = {0, k, k + 1};
+        int sw[3] = {k, 1, k};
+        int dx[3] = {x + offsetX, x + offsetX + kx, x + offsetX + w - kx};
+        int dw[3] = {kx, w - 2*kx, kx};
+        int dy[3] = {y + offsetY, y + offsetY + ky, y + offsetY + h - ky};
+        int dh[3] = {ky, h - 2*ky, ky};
+
+        for (int row = 0; row < 3; row++) {
+            for (int col = 0; col < 3; col++) {
+                if (dw[col] <= 0 || dh[row] <= 0) {
+                    continue;
+                }
+
+                SDL_Rect src = {sx[col], sx[row], sw[col], sw[row]};
+                SDL_Rect dst = {dx[col], dy[row], dw[col], dh[row]};
+                SDL_RenderCopy(renderer, tex, &src, &dst);
+            }
         }
-        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
     }
 
     void drawTexture(SDL_Texture * tex, SDL_Color c, int x, int y, int w, int h, int tx, int ty, int tw, int th) {
@@ -345,6 +689,136 @@ namespace SDLHelper {
         return surf;
     }
 
+    // Creates a transparent white surface for a shape, filling a table mapping coverage to a pixel value
+    static SDL_Surface * createShapeSurface(int w, int h, uint32_t * lut) {
+        SDL_Surface * surf = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_RGBA32);
+        if (surf == NULL) {
+            return NULL;
+        }
+
+        for (int i = 0; i < 256; i++) {
+            lut[i] = SDL_MapRGBA(surf->format, 255, 255, 255, i);
+        }
+        SDL_FillRect(surf, NULL, lut[0]);
+
+        // Increment counters
+        surfNum++;
+        memUsage += (surf->pitch * surf->h);
+        return surf;
+    }
+
+    // Returns the signed distance from a point (relative to the centre) to the edge of a rounded rectangle
+    static inline float roundRectDist(float x, float y, float hw, float hh, float r) {
+        float qx = std::fabs(x) - (hw - r);
+        float qy = std::fabs(y) - (hh - r);
+        float ox = std::max(qx, 0.0f);
+        float oy = std::max(qy, 0.0f);
+        return std::sqrt(ox*ox + oy*oy) + std::min(std::max(qx, qy), 0.0f) - r;
+    }
+
+    // Returns coverage (0 - 255) of a pixel given the distance from its centre to the shape's edge
+    static inline uint8_t coverage(float d) {
+        return std::min(std::max(0.5f - d, 0.0f), 1.0f) * 255.0f;
+    }
+
+    // Rasterises a filled (b == 0) or outlined rounded rectangle covering the whole surface
+    static void rasterRoundRect(SDL_Surface * surf, const uint32_t * lut, float r, float b) {
+        float hw = surf->w/2.0f;
+        float hh = surf->h/2.0f;
+        r = std::min(r, std::min(hw, hh));
+        b = std::min(b, std::min(hw, hh));
+        float ir = std::max(r - b, 0.0f);
+
+        // Columns outside of the corners only depend on the row
+        int k = std::min(static_cast<int>(std::ceil(std::max(r, b))) + 1, (surf->w + 1)/2);
+        for (int y = 0; y < surf->h; y++) {
+            uint32_t * row = reinterpret_cast<uint32_t *>(static_cast<uint8_t *>(surf->pixels) + y * surf->pitch);
+            float py = y + 0.5f - hh;
+
+            // Corner columns
+            for (int x = 0; x < surf->w; x++) {
+                if (x == k && surf->w - k > k) {
+                    x = surf->w - k;
+                }
+
+                float px = x + 0.5f - hw;
+                float d = roundRectDist(px, py, hw, hh, r);
+                if (b > 0) {
+                    d = std::max(d, -roundRectDist(px, py, hw - b, hh - b, ir));
+                }
+                row[x] = lut[coverage(d)];
+            }
+
+            // Straight section is one run
+            if (surf->w - k > k) {
+                float d = std::max(std::fabs(py) - hh, -hw);
+                if (b > 0) {
+                    d = std::max(d, -std::max(std::fabs(py) - (hh - b), -(hw - b)));
+                }
+                uint32_t v = lut[coverage(d)];
+                for (int x = k; x < surf->w - k; x++) {
+                    row[x] = v;
+                }
+            }
+        }
+    }
+
+    SDL_Surface * renderEllipseS(unsigned int xd, unsigned int yd) {
+        uint32_t lut[256];
+        SDL_Surface * surf = createShapeSurface(xd + 4, yd + 4, lut);
+        if (surf == NULL) {
+            return NULL;
+        }
+
+        // Same placement as the texture version always had (centred with a 2 pixel margin)
+        float cx = xd/2 + 2.5f;
+        float cy = yd/2 + 2.5f;
+        float rx = xd/2 + 0.5f;
+        float ry = yd/2 + 0.5f;
+        for (int y = 0; y < surf->h; y++) {
+            uint32_t * row = reinterpret_cast<uint32_t *>(static_cast<uint8_t *>(surf->pixels) + y * surf->pitch);
+            float py = y + 0.5f - cy;
+
+            // Pixels whose surrounding 2x2 box is inside the ellipse are fully covered,
+            // so only those near the edge need their distance calculated
+            float ey = std::fabs(py) + 1.0f;
+            float span = (ey < ry ? rx * std::sqrt(1.0f - (ey*ey)/(ry*ry)) - 1.0f : -1.0f);
+            for (int x = 0; x < surf->w; x++) {
+                if (std::fabs(x + 0.5f - cx) <= span) {
+                    row[x] = lut[255];
+                    continue;
+                }
+
+                // Approximate distance to an ellipse (scaled by the gradient)
+                float px = x + 0.5f - cx;
+                float k0 = std::sqrt((px*px)/(rx*rx) + (py*py)/(ry*ry));
+                float k1 = std::sqrt((px*px)/(rx*rx*rx*rx) + (py*py)/(ry*ry*ry*ry));
+                float d = (k1 > 0 ? k0 * (k0 - 1.0f)/k1 : -std::min(rx, ry));
+                row[x] = lut[coverage(d)];
+            }
+        }
+
+        return surf;
+    }
+
+    SDL_Surface * renderFilledRoundRectS(int w, int h, unsigned int r) {
+        uint32_t lut[256];
+        SDL_Surface * surf = createShapeSurface(w, h, lut);
+        if (surf != NULL) {
+            rasterRoundRect(surf, lut, r, 0);
+        }
+        return surf;
+    }
+
+    SDL_Surface * renderRoundRectS(int w, int h, unsigned int r, unsigned int b) {
+        uint32_t lut[256];
+        SDL_Surface * surf = createShapeSurface(w, h, lut);
+        if (surf != NULL && b > 0) {
+            rasterRoundRect(surf, lut, r, b);
+        }
+        return surf;
+    }
+
     SDL_Surface * renderRectS(int w, int h, unsigned int b) {
         SDL_Surface * surf = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_RGBA32);
         SDL_Rect rects[4];
@@ -405,26 +879,19 @@ namespace SDLHelper {
         // Lock cache mutex
         std::unique_lock<std::mutex> mtx(fontCacheMutex);
 
-        // Create font for given size if not already cached
-        if (customFont) {
-            if (fontCache[0].find(font_size) == fontCache[0].end()) {
-                fontCache[0][font_size] = TTF_OpenFont(customFontPath.c_str(), font_size);
-            }
-        } else {
-            for (int i = 0; i < PlSharedFontType_Total; i++) {
-                if (fontCache[i].find(font_size) == fontCache[i].end()) {
-                    fontCache[i][font_size] = TTF_OpenFontRW(SDL_RWFromMem(fontData[i].address, fontData[i].size), 1, font_size);
-                }
-            }
-        }
-
         // Simply render and convert if custom font
         SDL_Surface * surf;
         if (customFont) {
-            if (TTF_GetFontStyle(fontCache[0][font_size]) != style) {
-                TTF_SetFontStyle(fontCache[0][font_size], style);
+            TTF_Font * font = getFont(0, font_size);
+            if (font == nullptr) {
+                // Nothing can be drawn without the font
+                surf = SDL_CreateRGBSurfaceWithFormat(0, 0, 0, 32, SDL_PIXELFORMAT_RGBA32);
+            } else {
+                if (TTF_GetFontStyle(font) != style) {
+                    TTF_SetFontStyle(font, style);
+                }
+                surf = TTF_RenderUTF8_Blended(font, str.c_str(), SDL_Color{255, 255, 255, 255});
             }
-            surf = TTF_RenderUTF8_Blended(fontCache[0][font_size], str.c_str(), SDL_Color{255, 255, 255, 255});
 
         // Need to examine multiple fonts when using Nintendo's
         } else {
@@ -443,20 +910,20 @@ namespace SDLHelper {
                     break;
                 }
 
-                // Find which font contains current glyph
-                int fontIndex = 0;
-                for (int i = 0; i < PlSharedFontType_Total; i++) {
-                    if (TTF_GlyphIsProvided(fontCache[i][font_size], ch)) {
-                        fontIndex = i;
-                        break;
-                    }
+                // Find which font contains current glyph (skipping it if no font could be opened)
+                TTF_Font * font = getGlyphFont(ch, font_size);
+                if (font == nullptr) {
+                    continue;
                 }
 
                 // Draw character and insert surface into array
-                if (TTF_GetFontStyle(fontCache[fontIndex][font_size]) != style) {
-                    TTF_SetFontStyle(fontCache[fontIndex][font_size], style);
+                if (TTF_GetFontStyle(font) != style) {
+                    TTF_SetFontStyle(font, style);
+                }
+                SDL_Surface * tmp = TTF_RenderGlyph_Blended(font, ch, SDL_Color{255, 255, 255, 255});
+                if (tmp == NULL) {
+                    continue;
                 }
-                SDL_Surface * tmp = TTF_RenderGlyph_Blended(fontCache[fontIndex][font_size], ch, SDL_Color{255, 255, 255, 255});
                 width += tmp->w;
                 height = (tmp->h > height ? tmp->h : height);
                 surfs.push_back(tmp);
@@ -486,30 +953,66 @@ namespace SDLHelper {
         return surf;
     }
 
-    SDL_Surface * renderTextWrappedS(std::string str, int font_size, uint32_t max_w, int style) {
-        // Lock cache mutex
+    void getTextDimensions(std::string str, int font_size, int * w, int * h, int style) {
         std::lock_guard<std::mutex> mtx(fontCacheMutex);
 
-        // Create font for given size if not already cached
+        // Custom font can be measured in one go
         if (customFont) {
-            if (fontCache[0].find(font_size) == fontCache[0].end()) {
-                fontCache[0][font_size] = TTF_OpenFont(customFontPath.c_str(), font_size);
+            TTF_Font * font = getFont(0, font_size);
+            if (font == nullptr) {
+                *w = 0;
+                *h = 0;
+                return;
             }
-        } else {
-            for (int i = 0; i < PlSharedFontType_Total; i++) {
-                if (fontCache[i].find(font_size) == fontCache[i].end()) {
-                    fontCache[i][font_size] = TTF_OpenFontRW(SDL_RWFromMem(fontData[i].address, fontData[i].size), 1, font_size);
-                }
+            if (TTF_GetFontStyle(font) != style) {
+                TTF_SetFontStyle(font, style);
             }
+            TTF_SizeUTF8(font, str.c_str(), w, h);
+            return;
         }
 
+        // Otherwise sum glyph advances (picking fonts the same way as rendering does)
+        *w = 0;
+        *h = 0;
+        unsigned int pos = 0;
+        while (pos < str.length()) {
+            unsigned int posCopy = pos;
+            uint16_t ch = getUTF8Char(str, pos);
+            if (pos == posCopy) {
+                break;
+            }
+
+            TTF_Font * font = getGlyphFont(ch, font_size);
+            if (font == nullptr) {
+                continue;
+            }
+            if (TTF_GetFontStyle(font) != style) {
+                TTF_SetFontStyle(font, style);
+            }
+            int adv;
+            TTF_GlyphMetrics(font, ch, NULL, NULL, NULL, NULL, &adv);
+            *w += adv;
+            *h = std::max(*h, TTF_FontHeight(font));
+        }
+    }
+
+    SDL_Surface * renderTextWrappedS(std::string str, int font_size, uint32_t max_w, int style) {
+        // Lock cache mutex
+        std::lock_guard<std::mutex> mtx(fontCacheMutex);
+
         // Simply render and convert if custom font
         SDL_Surface * surf;
         if (customFont) {
-            if (TTF_GetFontStyle(fontCache[0][font_size]) != style) {
-                TTF_SetFontStyle(fontCache[0][font_size], style);
+            TTF_Font * font = getFont(0, font_size);
+            if (font == nullptr) {
+                // Nothing can be drawn without the font
+                surf = SDL_CreateRGBSurfaceWithFormat(0, 0, 0, 32, SDL_PIXELFORMAT_RGBA32);
+            } else {
+                if (TTF_GetFontStyle(font) != style) {
+                    TTF_SetFontStyle(font, style);
+                }
+                surf = TTF_RenderUTF8_Blended_Wrapped(font, str.c_str(), SDL_Color{255, 255, 255, 255}, max_w);
             }
-            surf = TTF_RenderUTF8_Blended_Wrapped(fontCache[0][font_size], str.c_str(), SDL_Color{255, 255, 255, 255}, max_w);
 
         // Need to examine multiple fonts when using Nintendo's
         } else {
@@ -565,21 +1068,18 @@ namespace SDLHelper {
                         break;
                     }
 
-                    // Find which font contains current glyph
-                    int fontIndex = 0;
-                    for (int i = 0; i < PlSharedFontType_Total; i++) {
-                        if (TTF_GlyphIsProvided(fontCache[i][font_size], ch)) {
-                            fontIndex = i;
-                            break;
-                        }
-                    }
+                    // Find which font contains current glyph (it takes no space if no font could be opened)
+                    TTF_Font * font = getGlyphFont(ch, font_size);
 
                     // Get dimensions of glyph and update variables
-                    int adv;
-                    TTF_GlyphMetrics(fontCache[fontIndex][font_size], ch, NULL, NULL, NULL, NULL, &adv);
+                    int adv = 0;
+                    int h = 0;
+                    if (font != nullptr) {
+                        TTF_GlyphMetrics(font, ch, NULL, NULL, NULL, NULL, &adv);
+                        h = TTF_FontLineSkip(font) - TTF_FontDescent(font);
+                    }
                     lastCharW = adv;
                     wordWidth += adv;
-                    int h = TTF_FontLineSkip(fontCache[fontIndex][font_size]) - TTF_FontDescent(fontCache[fontIndex][font_size]);
                     lineHeight = (h > lineHeight ? h : lineHeight);
                     word += str.substr(oldPos, charSize);
 
@@ -622,19 +1122,19 @@ namespace SDLHelper {
                     }
 
                     // Find which font contains current glyph
-                    int fontIndex = 0;
-                    for (int i = 0; i < PlSharedFontType_Total; i++) {
-                        if (TTF_GlyphIsProvided(fontCache[i][font_size], ch)) {
-                            fontIndex = i;
-                            break;
-                        }
+                    TTF_Font * font = getGlyphFont(ch, font_size);
+                    if (font == nullptr) {
+                        continue;
                     }
 
                     // Draw character and blit onto surface
-                    if (TTF_GetFontStyle(fontCache[fontIndex][font_size]) != style) {
-                        TTF_SetFontStyle(fontCache[fontIndex][font_size], style);
+                    if (TTF_GetFontStyle(font) != style) {
+                        TTF_SetFontStyle(font, style);
+                    }
+                    SDL_Surface * tmp = TTF_RenderGlyph_Blended(font, ch, SDL_Color{255, 255, 255, 255});
+                    if (tmp == NULL) {
+                        continue;
                     }
-                    SDL_Surface * tmp = TTF_RenderGlyph_Blended(fontCache[fontIndex][font_size], ch, SDL_Color{255, 255, 255, 255});
                     SDL_Rect r = SDL_Rect{x, i * (maxLineH * FONT_SPACING), tmp->w, tmp->h};
                     x += tmp->w;
                     SDL_BlitSurface(tmp, NULL, surf, &r);
@@ -654,43 +1154,23 @@ namespace SDLHelper {
 
     // -= TEXTURES =-
     SDL_Texture * renderEllipse(unsigned int xd, unsigned int yd) {
-        SDL_Texture * tex = createTexture(xd + 4, yd + 4);
-        renderToTexture(tex);
-        drawEllipse(SDL_Color{255, 255, 255, 255}, xd/2 + 2, yd/2 + 2, xd, yd);
-        renderToScreen();
-        return tex;
+        return convertSurfaceToTexture(renderEllipseS(xd, yd));
     }
 
     SDL_Texture * renderFilledRect(int w, int h) {
-        SDL_Texture * tex = createTexture(w, h);
-        renderToTexture(tex);
-        drawFilledRect(SDL_Color{255, 255, 255, 255}, 0, 0, w, h);
-        renderToScreen();
-        return tex;
+        return convertSurfaceToTexture(renderFilledRectS(w, h));
     }
 
     SDL_Texture * renderFilledRoundRect(int w, int h, unsigned int c) {
-        SDL_Texture * tex = createTexture(w, h);
-        renderToTexture(tex);
-        drawFilledRoundRect(SDL_Color{255, 255, 255, 255}, 0, 0, w, h, c);
-        renderToScreen();
-        return tex;
+        return convertSurfaceToTexture(renderFilledRoundRectS(w, h, c));
     }
 
     SDL_Texture * renderRoundRect(int w, int h, unsigned int r, unsigned int b) {
-        SDL_Texture * tex = createTexture(w, h);
-        renderToTexture(tex);
-        drawRoundRect(SDL_Color{255, 255, 255, 255}, 0, 0, w, h, r, b);
-        renderToScreen();
-        return tex;
+        return convertSurfaceToTexture(renderRoundRectS(w, h, r, b));
     }
 
     SDL_Texture * renderRect(int w, int h, unsigned int b) {
-        SDL_Texture * tex = createTexture(w, h);
-        renderToTexture(tex);
-        drawRect(SDL_Color{255, 255, 255, 255}, 0, 0, w, h, b);
-        renderToScreen();
-        return tex;
+        return convertSurfaceToTexture(renderRectS(w, h, b));
     }
 
     SDL_Texture * renderImage(std::string path, int xF, int yF) {
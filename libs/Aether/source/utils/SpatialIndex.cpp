@@ -0,0 +1,254 @@
+#include <algorithm>
+#include <cmath>
+#include "Aether/base/Element.hpp"
+#include "Aether/utils/SpatialIndex.hpp"
+#include <limits>
+
+// Size of each (square) grid cell in pixels
+#define CELL_SIZE 128
+
+namespace Aether {
+    SpatialIndex::SpatialIndex() {
+        this->clear();
+    }
+
+    int SpatialIndex::cellOf(int v) {
+        // Round towards negative infinity so negative co-ordinates work
+        return (v >= 0 ? v / CELL_SIZE : -((-v + CELL_SIZE - 1) / CELL_SIZE));
+    }
+
+    uint64_t SpatialIndex::key(int cx, int cy) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) | static_cast<uint32_t>(cy);
+    }
+
+    void SpatialIndex::addToCells(Element * e, const Entry & en) {
+        for (int cx = en.minCX; cx <= en.maxCX; cx++) {
+            for (int cy = en.minCY; cy <= en.maxCY; cy++) {
+                this->cells[key(cx, cy)].push_back(e);
+            }
+        }
+
+        this->minCX = std::min(this->minCX, en.minCX);
+        this->minCY = std::min(this->minCY, en.minCY);
+        this->maxCX = std::max(this->maxCX, en.maxCX);
+        this->maxCY = std::max(this->maxCY, en.maxCY);
+    }
+
+    void SpatialIndex::removeFromCells(Element * e, const Entry & en) {
+        for (int cx = en.minCX; cx <= en.maxCX; cx++) {
+            for (int cy = en.minCY; cy <= en.maxCY; cy++) {
+                std::unordered_map<uint64_t, std::vector<Element *> >::iterator it = this->cells.find(key(cx, cy));
+                if (it == this->cells.end()) {
+                    continue;
+                }
+
+                std::vector<Element *>::iterator pos = std::find(it->second.begin(), it->second.end(), e);
+                if (pos != it->second.end()) {
+                    it->second.erase(pos);
+                }
+                if (it->second.empty()) {
+                    this->cells.erase(it);
+                }
+            }
+        }
+    }
+
+    void SpatialIndex::insert(Element * e, SDL_Rect r) {
+        // Edges are inclusive as hit-testing and navigation treat them that way
+        Entry en;
+        en.rect = r;
+        en.minCX = cellOf(r.x);
+        en.minCY = cellOf(r.y);
+        en.maxCX = cellOf(r.x + std::max(r.w, 0));
+        en.maxCY = cellOf(r.y + std::max(r.h, 0));
+
+        std::unordered_map<Element *, Entry>::iterator it = this->entries.find(e);
+        if (it != this->entries.end()) {
+            // Only touch the cells if the covered range has changed
+            Entry & old = it->second;
+            if (old.minCX != en.minCX || old.minCY != en.minCY || old.maxCX != en.maxCX || old.maxCY != en.maxCY) {
+                this->removeFromCells(e, old);
+                this->addToCells(e, en);
+            }
+            en.order = old.order;
+            old = en;
+            return;
+        }
+
+        en.order = this->nextOrder++;
+        this->entries[e] = en;
+        this->addToCells(e, en);
+    }
+
+    void SpatialIndex::remove(Element * e) {
+        std::unordered_map<Element *, Entry>::iterator it = this->entries.find(e);
+        if (it != this->entries.end()) {
+            this->removeFromCells(e, it->second);
+            this->entries.erase(it);
+        }
+    }
+
+    void SpatialIndex::clear() {
+        this->cells.clear();
+        this->entries.clear();
+        this->nextOrder = 0;
+        this->minCX = std::numeric_limits<int>::max();
+        this->minCY = std::numeric_limits<int>::max();
+        this->maxCX = std::numeric_limits<int>::min();
+        this->maxCY = std::numeric_limits<int>::min();
+    }
+
+    void SpatialIndex::reorder(const std::vector<Element *> & v) {
+        for (size_t i = 0; i < v.size(); i++) {
+            std::unordered_map<Element *, Entry>::iterator it = this->entries.find(v[i]);
+            if (it != this->entries.end()) {
+                it->second.order = i;
+            }
+        }
+        this->nextOrder = v.size();
+    }
+
+    bool SpatialIndex::rect(Element * e, SDL_Rect * r) {
+        std::unordered_map<Element *, Entry>::iterator it = this->entries.find(e);
+        if (it == this->entries.end()) {
+            return false;
+        }
+
+        *r = it->second.rect;
+        return true;
+    }
+
+    void SpatialIndex::elementsAt(int x, int y, std::vector<Element *> & v) {
+        std::unordered_map<uint64_t, std::vector<Element *> >::iterator it = this->cells.find(key(cellOf(x), cellOf(y)));
+        if (it == this->cells.end()) {
+            return;
+        }
+
+        size_t first = v.size();
+        for (size_t i = 0; i < it->second.size(); i++) {
+            const SDL_Rect & r = this->entries[it->second[i]].rect;
+            if (x >= r.x && y >= r.y && x <= r.x + r.w && y <= r.y + r.h) {
+                v.push_back(it->second[i]);
+            }
+        }
+
+        // Moved elements are re-added at the end of a cell, so restore their order
+        if (v.size() - first > 1) {
+            std::sort(v.begin() + first, v.end(), [this](Element * a, Element * b) {
+                return this->entries[a].order < this->entries[b].order;
+            });
+        }
+    }
+
+    Element * SpatialIndex::nearest(Element * cur, Button b) {
+        SDL_Rect c;
+        if (!this->rect(cur, &c)) {
+            return nullptr;
+        }
+
+        // Point to measure from (middle of the edge facing the direction)
+        int ox, oy;
+        switch (b) {
+            case Button::DPAD_RIGHT:
+                ox = c.x + c.w;
+                oy = c.y + c.h/2;
+                break;
+
+            case Button::DPAD_LEFT:
+                ox = c.x;
+                oy = c.y + c.h/2;
+                break;
+
+            case Button::DPAD_UP:
+                ox = c.x + c.w/2;
+                oy = c.y;
+                break;
+
+            case Button::DPAD_DOWN:
+                ox = c.x + c.w/2;
+                oy = c.y + c.h;
+                break;
+
+            default:
+                return nullptr;
+        }
+
+        int ocx = cellOf(ox);
+        int ocy = cellOf(oy);
+        int maxRing = std::max(std::max(ocx - this->minCX, this->maxCX - ocx), std::max(ocy - this->minCY, this->maxCY - ocy));
+
+        Element * best = nullptr;
+        int minDist = std::numeric_limits<int>::max();
+        uint64_t bestOrder = 0;
+        for (int ring = 0; ring <= maxRing; ring++) {
+            // Every point in this ring is at least (ring - 1) cells away
+            if (best != nullptr && (ring - 1) * CELL_SIZE > minDist) {
+                break;
+            }
+
+            for (int cx = ocx - ring; cx <= ocx + ring; cx++) {
+                // Outer columns cover the whole ring, inner ones only the top and bottom cells
+                int step = ((cx == ocx - ring || cx == ocx + ring) ? 1 : 2*ring);
+                for (int cy = ocy - ring; cy <= ocy + ring; cy += step) {
+                    std::unordered_map<uint64_t, std::vector<Element *> >::iterator it = this->cells.find(key(cx, cy));
+                    if (it == this->cells.end()) {
+                        continue;
+                    }
+
+                    for (size_t i = 0; i < it->second.size(); i++) {
+                        Element * pot = it->second[i];
+                        if (pot == cur || pot->hidden() || !(pot->selectable() || pot->hasSelectable())) {
+                            continue;
+                        }
+
+                        // Check the element lies in the right direction and get the point to measure to
+                        const SDL_Rect & p = this->entries[pot].rect;
+                        int px, py;
+                        bool valid;
+                        switch (b) {
+                            case Button::DPAD_RIGHT:
+                                valid = (p.x >= c.x + c.w);
+                                px = p.x;
+                                py = p.y + p.h/2;
+                                break;
+
+                            case Button::DPAD_LEFT:
+                                valid = (p.x + p.w <= c.x);
+                                px = p.x + p.w;
+                                py = p.y + p.h/2;
+                                break;
+
+                            case Button::DPAD_UP:
+                                valid = (p.y + p.h <= c.y);
+                                px = p.x + p.w/2;
+                                py = p.y + p.h;
+                                break;
+
+                            default:
+                                valid = (p.y >= c.y + c.h);
+                                px = p.x + p.w/2;
+                                py = p.y;
+                                break;
+                        }
+
+                        // Only consider an element in the cell holding its measure point (avoids duplicates)
+                        if (!valid || cellOf(px) != cx || cellOf(py) != cy) {
+                            continue;
+                        }
+
+                        // Cells aren't visited in order, so ties are settled explicitly
+                        int dist = sqrt(pow(px - ox, 2) + pow(py - oy, 2));
+                        uint64_t order = this->entries[pot].order;
+                        if (dist < minDist || (dist == minDist && order < bestOrder)) {
+                            minDist = dist;
+                            best = pot;
+                            bestOrder = order;
+                        }
+                    }
+                }
+            }
+        }
+
+        return best;
+    }
+};
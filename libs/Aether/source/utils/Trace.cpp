@@ -0,0 +1,48 @@
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include "Aether/utils/Trace.hpp"
+#include <vector>
+
+// Time the program started (well, when static objects were constructed)
+static std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+// File to write to
+static std::string file;
+// Marks recorded so far (phase and microseconds since start)
+static std::vector< std::pair<std::string, long long> > marks;
+// Mutex protecting the above
+static std::mutex mutex;
+
+namespace Aether::Trace {
+    void setFile(std::string path) {
+        std::scoped_lock<std::mutex> mtx(mutex);
+        file = path;
+    }
+
+    void mark(std::string phase) {
+        long long us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+        std::scoped_lock<std::mutex> mtx(mutex);
+        marks.push_back(std::make_pair(phase, us));
+    }
+
+    bool flush() {
+        std::scoped_lock<std::mutex> mtx(mutex);
+        if (file.empty()) {
+            return false;
+        }
+
+        FILE * fp = fopen(file.c_str(), "w");
+        if (fp == nullptr) {
+            return false;
+        }
+
+        // Print time since start and time taken by the phase (in ms)
+        long long last = 0;
+        for (size_t i = 0; i < marks.size(); i++) {
+            fprintf(fp, "%10.3f ms (+%8.3f ms)  %s\n", marks[i].second/1000.0, (marks[i].second - last)/1000.0, marks[i].first.c_str());
+            last = marks[i].second;
+        }
+        fclose(fp);
+        return true;
+    }
+};
@@ -1,5 +1,8 @@
 #include "app.hpp"
 
+#include "assembler.hpp"
+#include "file_writer.hpp"
+#include "http.hpp"
 #include "main_screen.hpp"
 
 Application::Application() : m_display()
@@ -10,13 +13,25 @@ Application::Application() : m_display()
     // Set the colours to use for selections (see Display.hpp)
     m_display.setHighlightColours(Aether::Theme::Dark.highlightBG, Aether::Theme::Dark.selected);
 
+    // Completed requests wake the display if it is idle so their callbacks run straight away
+    http::Client::getInstance().setWakeFunction([this]() { m_display.wake(); });
+    requests::Assembler::getInstance().setWakeFunction([this]() { m_display.wake(); });
+
     // Set the screen our app will be starting with
     m_display.setScreen(&MainScreen::getInstance());
+    Aether::Trace::mark("Main screen created");
 }
 
 Application::~Application()
 {
     // m_display member will be automatically destroyed, cleaning up display services
+
+    // nothing may wake the display once it is gone
+    http::Client::getInstance().setWakeFunction(nullptr);
+    requests::Assembler::getInstance().setWakeFunction(nullptr);
+    requests::writeTimings();
+    // make sure queued output (e.g. the assembly cache) is on the card before exiting
+    io::FileWriter::getInstance().flush(true);
 }
 
 void Application::run()
@@ -25,6 +40,9 @@ void Application::run()
     // This runs at 60 times per second if possible
     while (getInstance().m_display.loop())
     {
-        // You could do some other processing in here
+        // Send instructions queued this frame together, then run callbacks of finished
+        // network requests on this (the UI) thread
+        requests::Assembler::getInstance().flush();
+        http::Client::getInstance().poll();
     }
 }
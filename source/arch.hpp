@@ -0,0 +1,13 @@
+#pragma once
+
+namespace requests {
+    enum class Arch
+    {
+        Arm64,
+        Arm,
+        Thumb,
+    };
+    auto constexpr ARCH_COUNT = 3;
+    // names used by the API for each Arch
+    inline constexpr const char *ARCH_NAMES[ARCH_COUNT] = {"arm64", "arm", "thumb"};
+}
@@ -0,0 +1,1267 @@
+#include "arm_assembler.hpp"
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace arm
+{
+    struct Named
+    {
+        const char *name;
+        uint32_t value;
+    };
+
+    static constexpr Named CONDITIONS[] = {
+        {"eq", 0x0}, {"ne", 0x1}, {"cs", 0x2}, {"hs", 0x2}, {"cc", 0x3}, {"lo", 0x3}, {"mi", 0x4}, {"pl", 0x5},
+        {"vs", 0x6}, {"vc", 0x7}, {"hi", 0x8}, {"ls", 0x9}, {"ge", 0xA}, {"lt", 0xB}, {"gt", 0xC}, {"le", 0xD},
+        {"al", 0xE},
+    };
+
+    static constexpr Named SHIFTS[] = {{"lsl", 0}, {"lsr", 1}, {"asr", 2}, {"ror", 3}};
+
+    // AArch32 register aliases
+    static constexpr Named REGISTERS32[] = {{"sb", 9}, {"sl", 10}, {"fp", 11}, {"ip", 12}, {"sp", 13}, {"lr", 14}, {"pc", 15}};
+
+    // ARM64 FMOV's 8-bit immediate is +/-(16 + m) / 16 * 2^e for m in 0-15 and e in -3-4
+    static constexpr double fmovImmediate(uint32_t imm8)
+    {
+        int exponent = static_cast<int>(((imm8 >> 4) & 7) ^ 4) - 3;
+        double value = (16 + (imm8 & 0xF)) / 16.0;
+        for (; exponent > 0; exponent--)
+            value *= 2;
+        for (; exponent < 0; exponent++)
+            value /= 2;
+        return (imm8 & 0x80) ? -value : value;
+    }
+
+    struct FmovTable
+    {
+        double values[256];
+
+        constexpr FmovTable() : values()
+        {
+            for (uint32_t i = 0; i < 256; i++)
+                values[i] = fmovImmediate(i);
+        }
+    };
+
+    static constexpr FmovTable FMOV_IMMEDIATES;
+
+    // ARM64 unsigned offset loads and stores, the unscaled and indexed forms clear bit 24
+    struct LoadStore64
+    {
+        const char *mnemonic;
+        char kind;          // register type of Rt
+        uint32_t base;
+        uint32_t scale;     // log2 of the access size
+    };
+
+    static constexpr LoadStore64 LOAD_STORE64[] = {
+        {"ldr", 'x', 0xF9400000, 3}, {"ldr", 'w', 0xB9400000, 2}, {"ldr", 'q', 0x3DC00000, 4},
+        {"ldr", 'd', 0xFD400000, 3}, {"ldr", 's', 0xBD400000, 2},
+        {"str", 'x', 0xF9000000, 3}, {"str", 'w', 0xB9000000, 2}, {"str", 'q', 0x3D800000, 4},
+        {"str", 'd', 0xFD000000, 3}, {"str", 's', 0xBD000000, 2},
+        {"ldrb", 'w', 0x39400000, 0}, {"strb", 'w', 0x39000000, 0},
+        {"ldrh", 'w', 0x79400000, 1}, {"strh", 'w', 0x79000000, 1},
+        {"ldrsw", 'x', 0xB9800000, 2},
+    };
+
+    // ARM64 PC relative loads
+    static constexpr LoadStore64 LOAD_LITERAL64[] = {
+        {"ldr", 'x', 0x58000000, 0}, {"ldr", 'w', 0x18000000, 0}, {"ldr", 'q', 0x9C000000, 0},
+        {"ldr", 'd', 0x5C000000, 0}, {"ldr", 's', 0x1C000000, 0}, {"ldrsw", 'x', 0x98000000, 0},
+    };
+
+    // ARM64 add/sub, 32-bit encodings (bit 31 is set for X registers), swapping add and sub flips bit 1 of the index
+    struct AddSub64
+    {
+        const char *mnemonic;
+        uint32_t immediate;
+        uint32_t shifted;
+        bool setFlags;
+    };
+
+    static constexpr AddSub64 ADD_SUB64[] = {
+        {"add", 0x11000000, 0x0B000000, false},
+        {"adds", 0x31000000, 0x2B000000, true},
+        {"sub", 0x51000000, 0x4B000000, false},
+        {"subs", 0x71000000, 0x6B000000, true},
+    };
+
+    static constexpr Named MOVE_WIDE64[] = {{"movn", 0x12800000}, {"movz", 0x52800000}, {"movk", 0x72800000}};
+
+    // AArch32 single register loads and stores
+    struct LoadStore32
+    {
+        const char *mnemonic;
+        uint32_t arm;           // immediate offset form
+        bool halfword;          // uses the split 8-bit offset encoding on ARM
+        uint32_t thumb;         // 32-bit Thumb imm12 form (first halfword), imm8 and register forms clear bit 7
+        uint32_t thumbShort;    // 16-bit Thumb [Rn, #imm] form
+        uint32_t thumbRegister; // 16-bit Thumb [Rn, Rm] form
+        uint32_t scale;         // log2 of the access size
+    };
+
+    static constexpr LoadStore32 LOAD_STORE32[] = {
+        {"ldr", 0x04100000, false, 0xF8D0, 0x6800, 0x5800, 2},
+        {"str", 0x04000000, false, 0xF8C0, 0x6000, 0x5000, 2},
+        {"ldrb", 0x04500000, false, 0xF890, 0x7800, 0x5C00, 0},
+        {"strb", 0x04400000, false, 0xF880, 0x7000, 0x5400, 0},
+        {"ldrh", 0x001000B0, true, 0xF8B0, 0x8800, 0x5A00, 1},
+        {"strh", 0x000000B0, true, 0xF8A0, 0x8000, 0x5200, 1},
+    };
+
+    // Mnemonics AArch32 can put S and condition suffixes on, longest first so LDRB isn't taken as LDR + B
+    static constexpr const char *BASES32[] = {
+        "movw", "movt", "ldrb", "strb", "ldrh", "strh", "cbnz", "mov", "mvn", "add", "sub", "cmp", "cmn",
+        "ldr", "str", "nop", "cbz", "bl", "bx", "b",
+    };
+
+    static bool lookup(const Named *table, size_t size, const std::string &name, uint32_t *value)
+    {
+        for (size_t i = 0; i < size; i++)
+        {
+            if (name == table[i].name)
+            {
+                *value = table[i].value;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template <size_t N>
+    static bool lookup(const Named (&table)[N], const std::string &name, uint32_t *value)
+    {
+        return lookup(table, N, name, value);
+    }
+
+    static Status fail(const char *message, std::string *out)
+    {
+        *out = message;
+        return Status::Error;
+    }
+
+    static Status emit32(uint32_t word, std::string *out)
+    {
+        char hex[9];
+        snprintf(hex, sizeof(hex), "%02X%02X%02X%02X", word & 0xFF, (word >> 8) & 0xFF, (word >> 16) & 0xFF, word >> 24);
+        *out = hex;
+        return Status::Ok;
+    }
+
+    static Status emitThumb(uint32_t halfword, std::string *out)
+    {
+        char hex[5];
+        snprintf(hex, sizeof(hex), "%02X%02X", halfword & 0xFF, (halfword >> 8) & 0xFF);
+        *out = hex;
+        return Status::Ok;
+    }
+
+    // 32-bit Thumb instructions are stored as two halfwords, first one first
+    static Status emitThumb2(uint32_t first, uint32_t second, std::string *out)
+    {
+        std::string low;
+        emitThumb(first, out);
+        emitThumb(second, &low);
+        *out += low;
+        return Status::Ok;
+    }
+
+    static bool inRange(int64_t value, int bits)
+    {
+        return value >= -(INT64_C(1) << (bits - 1)) && value < (INT64_C(1) << (bits - 1));
+    }
+
+    static std::string trim(const std::string &s)
+    {
+        size_t start = s.find_first_not_of(" \t");
+        if (start == std::string::npos)
+            return "";
+        return s.substr(start, s.find_last_not_of(" \t") - start + 1);
+    }
+
+    // splits on commas outside of brackets
+    static std::vector<std::string> splitOperands(const std::string &s)
+    {
+        std::vector<std::string> operands;
+        if (trim(s).empty())
+            return operands;
+
+        int depth = 0;
+        size_t start = 0;
+        for (size_t i = 0; i <= s.size(); i++)
+        {
+            if (i < s.size() && s[i] == '[')
+                depth++;
+            else if (i < s.size() && s[i] == ']')
+                depth--;
+            else if (i == s.size() || (s[i] == ',' && depth == 0))
+            {
+                operands.push_back(trim(s.substr(start, i - start)));
+                start = i + 1;
+            }
+        }
+        return operands;
+    }
+
+    // #123, #-0x10, 0x20 (labels aren't supported)
+    static bool parseNumber(const std::string &s, int64_t *value)
+    {
+        std::string t = trim(s);
+        if (!t.empty() && t[0] == '#')
+            t = trim(t.substr(1));
+        bool negative = (!t.empty() && t[0] == '-');
+        if (negative)
+            t = t.substr(1);
+        if (t.empty() || !isdigit(static_cast<unsigned char>(t[0])))
+            return false;
+
+        char *end;
+        uint64_t magnitude = strtoull(t.c_str(), &end, (t.size() > 2 && t[1] == 'x' && t[0] == '0') ? 16 : 10);
+        if (*end != '\0')
+            return false;
+        *value = (negative ? -static_cast<int64_t>(magnitude) : static_cast<int64_t>(magnitude));
+        return true;
+    }
+
+    static bool parseFloat(const std::string &s, double *value)
+    {
+        std::string t = trim(s);
+        if (t.empty() || t[0] != '#')
+            return false;
+        t = trim(t.substr(1));
+        char *end;
+        *value = strtod(t.c_str(), &end);
+        return !t.empty() && *end == '\0';
+    }
+
+    // "lsl #2" etc.
+    static bool parseShift(const std::string &s, uint32_t *type, int64_t *amount)
+    {
+        std::string t = trim(s);
+        return t.size() > 3 && lookup(SHIFTS, t.substr(0, 3), type) && isspace(static_cast<unsigned char>(t[3])) && parseNumber(t.substr(4), amount);
+    }
+
+    struct Memory
+    {
+        std::string base;
+        std::string index;      // register offset, empty if there isn't one
+        int64_t offset = 0;
+        int64_t shift = 0;      // of the index
+        bool hasOffset = false;
+        bool writeback = false; // [base, #offset]!
+    };
+
+    static bool parseMemory(const std::string &s, Memory *mem)
+    {
+        std::string t = trim(s);
+        if (!t.empty() && t.back() == '!')
+        {
+            mem->writeback = true;
+            t = trim(t.substr(0, t.size() - 1));
+        }
+        if (t.size() < 2 || t.front() != '[' || t.back() != ']')
+            return false;
+
+        auto parts = splitOperands(t.substr(1, t.size() - 2));
+        if (parts.empty() || parts.size() > 3)
+            return false;
+        mem->base = parts[0];
+        if (parts.size() == 1)
+            return !mem->writeback;
+
+        if (parseNumber(parts[1], &mem->offset))
+        {
+            mem->hasOffset = true;
+            return parts.size() == 2;
+        }
+
+        uint32_t type;
+        mem->index = parts[1];
+        return !mem->writeback && (parts.size() == 2 || (parseShift(parts[2], &type, &mem->shift) && type == 0));
+    }
+
+    // absolute branch targets, the same as the API takes
+    static bool parseTarget(const std::string &s, uint64_t *target)
+    {
+        int64_t value;
+        if (!parseNumber(s, &value) || value < 0)
+            return false;
+        *target = value;
+        return true;
+    }
+
+    /* ARM64 */
+
+    struct Reg64
+    {
+        char kind;      // x, w, q, d, s
+        uint32_t num;   // 31 is xzr/wzr unless sp is set
+        bool sp;
+    };
+
+    static bool parseReg64(const std::string &s, Reg64 *reg)
+    {
+        if (s == "sp" || s == "wsp")
+            *reg = Reg64{s[0] == 'w' ? 'w' : 'x', 31, true};
+        else if (s == "xzr" || s == "wzr")
+            *reg = Reg64{s[0], 31, false};
+        else if (s == "lr" || s == "fp")
+            *reg = Reg64{'x', s == "lr" ? 30u : 29u, false};
+        else
+        {
+            if (s.size() < 2 || s.size() > 3 || strchr("xwqds", s[0]) == nullptr)
+                return false;
+            for (size_t i = 1; i < s.size(); i++)
+            {
+                if (!isdigit(static_cast<unsigned char>(s[i])))
+                    return false;
+            }
+            uint32_t num = atoi(s.c_str() + 1);
+            if (num > 31 || (num == 31 && (s[0] == 'x' || s[0] == 'w')))
+                return false;
+            *reg = Reg64{s[0], num, false};
+        }
+        return true;
+    }
+
+    static bool isGeneral(const Reg64 &reg)
+    {
+        return reg.kind == 'x' || reg.kind == 'w';
+    }
+
+    // logical immediates are a rotated run of ones, repeated across the register in 2-64 bit elements
+    static bool encodeBitmask(uint64_t value, bool wide, uint32_t *fields)
+    {
+        if (!wide)
+        {
+            value &= 0xFFFFFFFF;
+            value |= value << 32;
+        }
+        if (value == 0 || value == ~UINT64_C(0))
+            return false;
+
+        uint32_t size = 64;
+        while (size > 2)
+        {
+            uint32_t half = size / 2;
+            uint64_t mask = (UINT64_C(1) << half) - 1;
+            if ((value & mask) != ((value >> half) & mask))
+                break;
+            size = half;
+        }
+
+        uint64_t mask = (size == 64 ? ~UINT64_C(0) : (UINT64_C(1) << size) - 1);
+        uint64_t element = value & mask;
+        uint32_t ones = __builtin_popcountll(element);
+        uint64_t run = (UINT64_C(1) << ones) - 1;
+        for (uint32_t r = 0; r < size; r++)
+        {
+            uint64_t rotated = (r == 0 ? element : ((element >> r) | (element << (size - r))) & mask);
+            if (rotated == run)
+            {
+                uint32_t n = (size == 64 ? 1 : 0);
+                uint32_t immr = (size - r) % size;
+                uint32_t imms = ((~(size - 1) << 1) | (ones - 1)) & 0x3F;
+                *fields = (n << 22) | (immr << 16) | (imms << 10);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static Status branch64(const std::string &mn, const std::vector<std::string> &ops, uint64_t address, std::string *out)
+    {
+        uint64_t target;
+        if (ops.size() != 1 || !parseTarget(ops[0], &target))
+            return Status::Unsupported;
+        int64_t delta = target - address;
+        if (delta & 3)
+            return fail("branch target isn't aligned", out);
+        if (!inRange(delta >> 2, 26))
+            return fail("branch target out of range", out);
+        return emit32((mn == "bl" ? 0x94000000 : 0x14000000) | ((delta >> 2) & 0x3FFFFFF), out);
+    }
+
+    // B.cond, CBZ and CBNZ share the 19-bit offset
+    static Status offset19(uint32_t base, const std::string &targetOperand, uint64_t address, std::string *out)
+    {
+        uint64_t target;
+        if (!parseTarget(targetOperand, &target))
+            return Status::Unsupported;
+        int64_t delta = target - address;
+        if (delta & 3)
+            return fail("branch target isn't aligned", out);
+        if (!inRange(delta >> 2, 19))
+            return fail("branch target out of range", out);
+        return emit32(base | ((delta >> 2) & 0x7FFFF) << 5, out);
+    }
+
+    static Status move64(const Reg64 &rd, const std::string &source, std::string *out)
+    {
+        bool wide = (rd.kind == 'x');
+        uint32_t sf = (wide ? 0x80000000 : 0);
+        Reg64 rm;
+        int64_t imm;
+
+        if (parseReg64(source, &rm))
+        {
+            if (!isGeneral(rm) || rm.kind != rd.kind)
+                return Status::Unsupported;
+            // to or from the stack pointer is an ADD, otherwise ORR with the zero register
+            if (rd.sp || rm.sp)
+                return emit32(sf | 0x11000000 | rm.num << 5 | rd.num, out);
+            return emit32(sf | 0x2A0003E0 | rm.num << 16 | rd.num, out);
+        }
+
+        if (!parseNumber(source, &imm) || rd.sp)
+            return Status::Unsupported;
+        if (!wide && (imm < INT32_MIN || imm > UINT32_MAX))
+            return fail("immediate out of range", out);
+
+        // MOVZ, then MOVN, then ORR with a logical immediate
+        uint64_t mask = (wide ? ~UINT64_C(0) : 0xFFFFFFFF);
+        uint64_t value = static_cast<uint64_t>(imm) & mask;
+        for (int inverted = 0; inverted < 2; inverted++)
+        {
+            uint64_t v = (inverted ? ~value & mask : value);
+            for (uint32_t hw = 0; hw < (wide ? 4u : 2u); hw++)
+            {
+                if ((v & ~(UINT64_C(0xFFFF) << (hw * 16))) == 0)
+                    return emit32(sf | (inverted ? 0x12800000 : 0x52800000) | hw << 21 | ((v >> (hw * 16)) & 0xFFFF) << 5 | rd.num, out);
+            }
+        }
+
+        uint32_t fields;
+        if (encodeBitmask(value, wide, &fields))
+            return emit32(sf | 0x320003E0 | fields | rd.num, out);
+        return fail("immediate can't be encoded in one instruction", out);
+    }
+
+    static Status addSub64(size_t index, std::vector<std::string> ops, std::string *out)
+    {
+        Reg64 rd, rn, rm;
+        if (ops.size() < 3 || ops.size() > 4 || !parseReg64(ops[0], &rd) || !parseReg64(ops[1], &rn))
+            return Status::Unsupported;
+        if (!isGeneral(rd) || rd.kind != rn.kind)
+            return Status::Unsupported;
+        uint32_t sf = (rd.kind == 'x' ? 0x80000000 : 0);
+
+        int64_t imm;
+        if (parseNumber(ops[2], &imm))
+        {
+            // 31 is the stack pointer for Rn, and for Rd unless the flags are set
+            if ((!rn.sp && rn.num == 31) || (rd.num == 31 && rd.sp == ADD_SUB64[index].setFlags))
+                return Status::Unsupported;
+
+            uint32_t shift = 0;
+            int64_t amount;
+            uint32_t type;
+            if (ops.size() == 4)
+            {
+                if (!parseShift(ops[3], &type, &amount) || type != 0 || (amount != 0 && amount != 12))
+                    return Status::Unsupported;
+                shift = (amount == 12);
+            }
+            if (imm < 0)
+            {
+                index ^= 2;
+                imm = -imm;
+            }
+            if (shift == 0 && imm > 0xFFF && (imm & 0xFFF) == 0)
+            {
+                shift = 1;
+                imm >>= 12;
+            }
+            if (imm > 0xFFF)
+                return fail("immediate out of range", out);
+            return emit32(sf | ADD_SUB64[index].immediate | shift << 22 | imm << 10 | rn.num << 5 | rd.num, out);
+        }
+
+        // the stack pointer needs the extended register form
+        if (!parseReg64(ops[2], &rm) || rm.kind != rd.kind || rd.sp || rn.sp || rm.sp)
+            return Status::Unsupported;
+        uint32_t type = 0;
+        int64_t amount = 0;
+        if (ops.size() == 4 && (!parseShift(ops[3], &type, &amount) || type == 3))
+            return Status::Unsupported;
+        if (amount < 0 || amount >= (sf ? 64 : 32))
+            return fail("shift out of range", out);
+        return emit32(sf | ADD_SUB64[index].shifted | type << 22 | rm.num << 16 | amount << 10 | rn.num << 5 | rd.num, out);
+    }
+
+    static Status fmov64(const std::vector<std::string> &ops, std::string *out)
+    {
+        Reg64 rd, rn;
+        if (ops.size() != 2 || !parseReg64(ops[0], &rd) || rd.sp)
+            return Status::Unsupported;
+
+        double value;
+        if (parseFloat(ops[1], &value))
+        {
+            if (rd.kind != 's' && rd.kind != 'd')
+                return Status::Unsupported;
+            uint32_t type = (rd.kind == 'd' ? 0x00400000 : 0);
+            // +0.0 has no immediate, it comes from the zero register instead
+            if (value == 0 && !std::signbit(value))
+                return emit32((rd.kind == 'd' ? 0x9E6703E0 : 0x1E2703E0) | rd.num, out);
+            for (uint32_t imm8 = 0; imm8 < 256; imm8++)
+            {
+                if (FMOV_IMMEDIATES.values[imm8] == value)
+                    return emit32(0x1E201000 | type | imm8 << 13 | rd.num, out);
+            }
+            return fail("floating point immediate can't be encoded", out);
+        }
+
+        if (!parseReg64(ops[1], &rn) || rn.sp)
+            return Status::Unsupported;
+        if (rd.kind == rn.kind && (rd.kind == 's' || rd.kind == 'd'))
+            return emit32((rd.kind == 'd' ? 0x1E604000 : 0x1E204000) | rn.num << 5 | rd.num, out);
+
+        // between general and floating point registers of the same size
+        static constexpr struct
+        {
+            char to, from;
+            uint32_t base;
+        } TRANSFERS[] = {{'s', 'w', 0x1E270000}, {'w', 's', 0x1E260000}, {'d', 'x', 0x9E670000}, {'x', 'd', 0x9E660000}};
+        for (auto &t : TRANSFERS)
+        {
+            if (rd.kind == t.to && rn.kind == t.from)
+                return emit32(t.base | rn.num << 5 | rd.num, out);
+        }
+        return Status::Unsupported;
+    }
+
+    static Status loadStore64(std::string mn, const std::vector<std::string> &ops, uint64_t address, std::string *out)
+    {
+        // LDUR and friends are the unscaled form of LDR
+        bool unscaled = (mn.size() > 3 && mn[2] == 'u');
+        if (unscaled)
+            mn.erase(2, 1);
+
+        Reg64 rt;
+        if (ops.size() < 2 || ops.size() > 3 || !parseReg64(ops[0], &rt) || rt.sp)
+            return Status::Unsupported;
+
+        if (ops.size() == 2 && ops[1][0] != '[')
+        {
+            if (unscaled)
+                return Status::Unsupported;
+            for (auto &ls : LOAD_LITERAL64)
+            {
+                if (mn == ls.mnemonic && rt.kind == ls.kind)
+                    return offset19(ls.base | rt.num, ops[1], address, out);
+            }
+            return Status::Unsupported;
+        }
+
+        const LoadStore64 *ls = nullptr;
+        for (auto &entry : LOAD_STORE64)
+        {
+            if (mn == entry.mnemonic && rt.kind == entry.kind)
+                ls = &entry;
+        }
+        Memory mem;
+        Reg64 rn, rm;
+        if (ls == nullptr || !parseMemory(ops[1], &mem) || !parseReg64(mem.base, &rn) || rn.kind != 'x' || (rn.num == 31 && !rn.sp))
+            return Status::Unsupported;
+
+        uint32_t base = ls->base | rn.num << 5 | rt.num;
+        uint32_t unscaledBase = base & ~0x01000000;
+        int64_t imm;
+
+        // [Xn], #imm
+        if (ops.size() == 3)
+        {
+            if (unscaled || mem.hasOffset || !mem.index.empty() || !parseNumber(ops[2], &imm))
+                return Status::Unsupported;
+            if (!inRange(imm, 9))
+                return fail("offset out of range", out);
+            return emit32(unscaledBase | (imm & 0x1FF) << 12 | 0x400, out);
+        }
+
+        // [Xn, #imm]!
+        if (mem.writeback)
+        {
+            if (unscaled)
+                return Status::Unsupported;
+            if (!inRange(mem.offset, 9))
+                return fail("offset out of range", out);
+            return emit32(unscaledBase | (mem.offset & 0x1FF) << 12 | 0xC00, out);
+        }
+
+        // [Xn, Xm{, lsl #scale}]
+        if (!mem.index.empty())
+        {
+            if (unscaled || !parseReg64(mem.index, &rm) || rm.kind != 'x' || rm.sp)
+                return Status::Unsupported;
+            if (mem.shift != 0 && mem.shift != ls->scale)
+                return fail("shift must match the access size", out);
+            return emit32(unscaledBase | 0x00206800 | rm.num << 16 | (mem.shift != 0) << 12, out);
+        }
+
+        // [Xn{, #imm}], scaled when it can be and unscaled otherwise
+        int64_t step = INT64_C(1) << ls->scale;
+        if (!unscaled && mem.offset >= 0 && mem.offset % step == 0 && mem.offset / step <= 0xFFF)
+            return emit32(base | (mem.offset / step) << 10, out);
+        if (!inRange(mem.offset, 9))
+            return fail("offset out of range", out);
+        return emit32(unscaledBase | (mem.offset & 0x1FF) << 12, out);
+    }
+
+    static Status assemble64(const std::string &mn, const std::vector<std::string> &ops, uint64_t address, std::string *out)
+    {
+        uint32_t value;
+        Reg64 rd;
+
+        if (mn == "nop")
+            return (ops.empty() ? emit32(0xD503201F, out) : Status::Unsupported);
+
+        if (mn == "ret" || mn == "br" || mn == "blr")
+        {
+            Reg64 rn{'x', 30, false};
+            if (ops.size() > 1 || (ops.empty() && mn != "ret") || (ops.size() == 1 && (!parseReg64(ops[0], &rn) || rn.kind != 'x' || rn.sp)))
+                return Status::Unsupported;
+            return emit32((mn == "ret" ? 0xD65F0000 : (mn == "br" ? 0xD61F0000 : 0xD63F0000)) | rn.num << 5, out);
+        }
+
+        if (mn == "b" || mn == "bl")
+            return branch64(mn, ops, address, out);
+
+        // b.eq, also accepted as beq
+        if (mn.size() == 4 && mn.compare(0, 2, "b.") == 0 && lookup(CONDITIONS, mn.substr(2), &value))
+            return (ops.size() == 1 ? offset19(0x54000000 | value, ops[0], address, out) : Status::Unsupported);
+        if (mn.size() == 3 && mn[0] == 'b' && lookup(CONDITIONS, mn.substr(1), &value))
+            return (ops.size() == 1 ? offset19(0x54000000 | value, ops[0], address, out) : Status::Unsupported);
+
+        if (mn == "cbz" || mn == "cbnz")
+        {
+            if (ops.size() != 2 || !parseReg64(ops[0], &rd) || !isGeneral(rd) || rd.sp)
+                return Status::Unsupported;
+            return offset19((rd.kind == 'x' ? 0x80000000 : 0) | (mn == "cbz" ? 0x34000000 : 0x35000000) | rd.num, ops[1], address, out);
+        }
+
+        if (lookup(MOVE_WIDE64, mn, &value))
+        {
+            int64_t imm, shift = 0;
+            uint32_t type;
+            if (ops.size() < 2 || ops.size() > 3 || !parseReg64(ops[0], &rd) || !isGeneral(rd) || rd.sp || !parseNumber(ops[1], &imm))
+                return Status::Unsupported;
+            if (ops.size() == 3 && (!parseShift(ops[2], &type, &shift) || type != 0))
+                return Status::Unsupported;
+            if (imm < 0 || imm > 0xFFFF)
+                return fail("immediate out of range", out);
+            if (shift % 16 != 0 || shift < 0 || shift > (rd.kind == 'x' ? 48 : 16))
+                return fail("shift must be a multiple of 16 within the register", out);
+            return emit32((rd.kind == 'x' ? 0x80000000 : 0) | value | (shift / 16) << 21 | imm << 5 | rd.num, out);
+        }
+
+        if (mn == "mov")
+        {
+            if (ops.size() != 2 || !parseReg64(ops[0], &rd) || !isGeneral(rd))
+                return Status::Unsupported;
+            return move64(rd, ops[1], out);
+        }
+
+        for (size_t i = 0; i < sizeof(ADD_SUB64) / sizeof(ADD_SUB64[0]); i++)
+        {
+            if (mn == ADD_SUB64[i].mnemonic)
+                return addSub64(i, ops, out);
+        }
+
+        // comparisons set the flags and discard the result
+        if (mn == "cmp" || mn == "cmn")
+        {
+            if (ops.empty() || !parseReg64(ops[0], &rd) || !isGeneral(rd))
+                return Status::Unsupported;
+            auto full = ops;
+            full.insert(full.begin(), rd.kind == 'x' ? "xzr" : "wzr");
+            return addSub64(mn == "cmp" ? 3 : 1, full, out);
+        }
+
+        if (mn == "fmov")
+            return fmov64(ops, out);
+
+        if (mn.compare(0, 2, "ld") == 0 || mn.compare(0, 2, "st") == 0)
+            return loadStore64(mn, ops, address, out);
+
+        return Status::Unsupported;
+    }
+
+    /* AArch32 (ARM and Thumb) */
+
+    static bool parseReg32(const std::string &s, uint32_t *reg)
+    {
+        if (lookup(REGISTERS32, s, reg))
+            return true;
+        if (s.size() < 2 || s.size() > 3 || s[0] != 'r')
+            return false;
+        for (size_t i = 1; i < s.size(); i++)
+        {
+            if (!isdigit(static_cast<unsigned char>(s[i])))
+                return false;
+        }
+        *reg = atoi(s.c_str() + 1);
+        return *reg <= 15;
+    }
+
+    // SP and PC are UNPREDICTABLE (or select another instruction) in most 32-bit Thumb register fields,
+    // such uses are left to the API
+    static bool isSpOrPc(uint32_t reg)
+    {
+        return reg == 13 || reg == 15;
+    }
+
+    static uint32_t rotateLeft(uint32_t value, uint32_t amount)
+    {
+        amount &= 31;
+        return (amount == 0 ? value : (value << amount) | (value >> (32 - amount)));
+    }
+
+    // ARM immediates are 8 bits rotated right by an even amount
+    static bool armImmediate(uint32_t value, uint32_t *encoded)
+    {
+        for (uint32_t rotate = 0; rotate < 16; rotate++)
+        {
+            uint32_t unrotated = rotateLeft(value, rotate * 2);
+            if (unrotated <= 0xFF)
+            {
+                *encoded = rotate << 8 | unrotated;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Thumb immediates are a byte repeated in one of three patterns, or 1bcdefgh rotated, as i:imm3:imm8
+    static bool thumbImmediate(uint32_t value, uint32_t *encoded)
+    {
+        uint32_t low = value & 0xFF;
+        uint32_t high = (value >> 8) & 0xFF;
+        if (value <= 0xFF)
+            *encoded = value;
+        else if (value == (low << 16 | low))
+            *encoded = 0x100 | low;
+        else if (value == (high << 24 | high << 8))
+            *encoded = 0x200 | high;
+        else if (value == low * 0x01010101)
+            *encoded = 0x300 | low;
+        else
+        {
+            for (uint32_t rotate = 8; rotate < 32; rotate++)
+            {
+                uint32_t unrotated = rotateLeft(value, rotate);
+                if (unrotated <= 0xFF && (unrotated & 0x80) != 0)
+                {
+                    *encoded = rotate << 7 | (unrotated & 0x7F);
+                    return true;
+                }
+            }
+            return false;
+        }
+        return true;
+    }
+
+    // spreads a 12-bit Thumb immediate (or the low 12 bits of a 16-bit one) over i:imm3:imm8
+    static uint32_t thumbSplit(uint32_t imm12, uint32_t *first)
+    {
+        *first |= (imm12 >> 11 & 1) << 10;
+        return (imm12 >> 8 & 7) << 12 | (imm12 & 0xFF);
+    }
+
+    // breaks a mnemonic into its base, an S suffix and a condition
+    static bool splitMnemonic32(const std::string &mn, std::string *base, bool *setFlags, uint32_t *cond)
+    {
+        for (auto *name : BASES32)
+        {
+            size_t length = strlen(name);
+            if (mn.compare(0, length, name) != 0)
+                continue;
+
+            std::string rest = mn.substr(length);
+            bool s = false;
+            bool flags = (strcmp(name, "mov") == 0 || strcmp(name, "mvn") == 0 || strcmp(name, "add") == 0 || strcmp(name, "sub") == 0);
+            if (flags && !rest.empty() && rest[0] == 's' && !lookup(CONDITIONS, rest, cond))
+            {
+                s = true;
+                rest = rest.substr(1);
+            }
+            // .w asks for a 32-bit Thumb encoding, which is what these give anyway
+            if (rest.size() >= 2 && rest.compare(rest.size() - 2, 2, ".w") == 0)
+                rest = rest.substr(0, rest.size() - 2);
+            *cond = 0xE;
+            if (!rest.empty() && !lookup(CONDITIONS, rest, cond))
+                continue;
+
+            *base = name;
+            *setFlags = s;
+            return true;
+        }
+        return false;
+    }
+
+    static Status loadStore32(const LoadStore32 &ls, uint32_t cond, bool thumb, const std::vector<std::string> &ops, uint64_t address, std::string *out)
+    {
+        uint32_t rt, rn, rm;
+        Memory mem;
+        if (ops.size() < 2 || ops.size() > 3 || !parseReg32(ops[0], &rt))
+            return Status::Unsupported;
+
+        // PC relative, only for ARM (Thumb aligns the PC first)
+        if (ops.size() == 2 && ops[1][0] != '[')
+        {
+            uint64_t target;
+            if (thumb || ls.halfword || !parseTarget(ops[1], &target) || strcmp(ls.mnemonic, "ldr") != 0)
+                return Status::Unsupported;
+            mem.base = "pc";
+            mem.offset = static_cast<int64_t>(target - (address + 8));
+            mem.hasOffset = true;
+        }
+        else if (!parseMemory(ops[1], &mem))
+            return Status::Unsupported;
+
+        // Thumb forms with Rn = PC are LDR (literal), which has its own rules
+        if (!parseReg32(mem.base, &rn) || (thumb && rn == 15))
+            return Status::Unsupported;
+        // byte and halfword transfers can't use SP or PC in Thumb, and only LDR can load the PC
+        if (thumb && ((ls.scale < 2 && isSpOrPc(rt)) || (rt == 15 && strcmp(ls.mnemonic, "ldr") != 0)))
+            return Status::Unsupported;
+
+        // offset (P set, W clear), pre-indexed (P and W set) or post-indexed (both clear)
+        bool post = (ops.size() == 3);
+        int64_t offset = mem.offset;
+        if (post && (mem.hasOffset || !mem.index.empty() || !parseNumber(ops[2], &offset)))
+            return Status::Unsupported;
+        bool pre = !post;
+        bool writeback = mem.writeback;
+        if ((writeback || post) && rn == 15)
+            return Status::Unsupported;
+        if ((writeback || post) && rt == rn)
+            return fail("base register can't be written back when it's also transferred", out);
+        bool up = (offset >= 0);
+        uint32_t magnitude = (up ? offset : -offset);
+
+        if (!mem.index.empty())
+        {
+            if (!parseReg32(mem.index, &rm))
+                return Status::Unsupported;
+            if (!thumb)
+            {
+                if (ls.halfword)
+                {
+                    if (mem.shift != 0)
+                        return Status::Unsupported;
+                    return emit32(cond << 28 | (ls.arm & ~0x00400000) | 1 << 24 | 1 << 23 | rn << 16 | rt << 12 | rm, out);
+                }
+                if (mem.shift > 31)
+                    return fail("shift out of range", out);
+                return emit32(cond << 28 | ls.arm | 0x02000000 | 1 << 24 | 1 << 23 | rn << 16 | rt << 12 | mem.shift << 7 | rm, out);
+            }
+
+            if (rt < 8 && rn < 8 && rm < 8 && mem.shift == 0)
+                return emitThumb(ls.thumbRegister | rm << 6 | rn << 3 | rt, out);
+            if (isSpOrPc(rm))
+                return Status::Unsupported;
+            if (mem.shift > 3)
+                return fail("shift out of range", out);
+            return emitThumb2((ls.thumb & ~0x80) | rn, rt << 12 | mem.shift << 4 | rm, out);
+        }
+
+        if (!thumb)
+        {
+            uint32_t p = (pre ? 1u << 24 : 0);
+            uint32_t w = (writeback ? 1u << 21 : 0);
+            uint32_t u = (up ? 1u << 23 : 0);
+            if (ls.halfword)
+            {
+                if (magnitude > 0xFF)
+                    return fail("offset out of range", out);
+                return emit32(cond << 28 | ls.arm | p | u | w | 1 << 22 | rn << 16 | rt << 12 | (magnitude >> 4) << 8 | (magnitude & 0xF), out);
+            }
+            if (magnitude > 0xFFF)
+                return fail("offset out of range", out);
+            return emit32(cond << 28 | ls.arm | p | u | w | rn << 16 | rt << 12 | magnitude, out);
+        }
+
+        // 16-bit forms for low registers with a small positive offset, including [sp, #imm] for words
+        uint32_t step = 1 << ls.scale;
+        if (pre && !writeback && up && magnitude % step == 0)
+        {
+            if (rt < 8 && rn < 8 && magnitude / step <= 31)
+                return emitThumb(ls.thumbShort | (magnitude / step) << 6 | rn << 3 | rt, out);
+            if (rn == 13 && rt < 8 && ls.scale == 2 && magnitude / 4 <= 0xFF)
+                return emitThumb((ls.thumbShort == 0x6800 ? 0x9800 : 0x9000) | rt << 8 | magnitude / 4, out);
+        }
+        if (pre && !writeback && up)
+        {
+            if (magnitude > 0xFFF)
+                return fail("offset out of range", out);
+            return emitThumb2(ls.thumb | rn, rt << 12 | magnitude, out);
+        }
+        if (magnitude > 0xFF)
+            return fail("offset out of range", out);
+        return emitThumb2((ls.thumb & ~0x80) | rn, rt << 12 | 0x800 | pre << 10 | up << 9 | (writeback || post) << 8 | magnitude, out);
+    }
+
+    static Status assembleArm(const std::string &mn, const std::vector<std::string> &ops, uint64_t address, std::string *out)
+    {
+        std::string base;
+        bool s;
+        uint32_t cond, rd, rn, rm, encoded;
+        int64_t imm;
+        // .w only means something to Thumb
+        if (!splitMnemonic32(mn, &base, &s, &cond) || mn.find('.') != std::string::npos)
+            return Status::Unsupported;
+        cond <<= 28;
+        uint32_t flags = (s ? 1u << 20 : 0);
+
+        if (base == "nop")
+            return (ops.empty() ? emit32(cond | 0x0320F000, out) : Status::Unsupported);
+
+        if (base == "bx")
+            return (ops.size() == 1 && parseReg32(ops[0], &rm) ? emit32(cond | 0x012FFF10 | rm, out) : Status::Unsupported);
+
+        if (base == "b" || base == "bl")
+        {
+            uint64_t target;
+            if (ops.size() != 1 || !parseTarget(ops[0], &target))
+                return Status::Unsupported;
+            int64_t delta = target - (address + 8);
+            if (delta & 3)
+                return fail("branch target isn't aligned", out);
+            if (!inRange(delta >> 2, 24))
+                return fail("branch target out of range", out);
+            return emit32(cond | (base == "bl" ? 0x0B000000 : 0x0A000000) | ((delta >> 2) & 0xFFFFFF), out);
+        }
+
+        if (base == "movw" || base == "movt")
+        {
+            if (ops.size() != 2 || !parseReg32(ops[0], &rd) || !parseNumber(ops[1], &imm))
+                return Status::Unsupported;
+            if (imm < 0 || imm > 0xFFFF)
+                return fail("immediate out of range", out);
+            return emit32(cond | (base == "movw" ? 0x03000000 : 0x03400000) | (imm >> 12) << 16 | rd << 12 | (imm & 0xFFF), out);
+        }
+
+        if (base == "mov" || base == "mvn")
+        {
+            if (ops.size() != 2 || !parseReg32(ops[0], &rd))
+                return Status::Unsupported;
+            uint32_t op = (base == "mov" ? 0x01A00000 : 0x01E00000);
+            if (parseReg32(ops[1], &rm))
+                return emit32(cond | op | flags | rd << 12 | rm, out);
+            if (!parseNumber(ops[1], &imm) || imm < INT32_MIN || imm > UINT32_MAX)
+                return Status::Unsupported;
+
+            // MOV and MVN swap to fit the immediate, then MOVW for 16 bits
+            uint32_t value = imm;
+            if (armImmediate(value, &encoded))
+                return emit32(cond | 0x02000000 | op | flags | rd << 12 | encoded, out);
+            if (armImmediate(~value, &encoded))
+                return emit32(cond | 0x02000000 | (op ^ 0x00400000) | flags | rd << 12 | encoded, out);
+            if (base == "mov" && !s && value <= 0xFFFF)
+                return emit32(cond | 0x03000000 | (value >> 12) << 16 | rd << 12 | (value & 0xFFF), out);
+            return fail("immediate can't be encoded", out);
+        }
+
+        if (base == "add" || base == "sub" || base == "cmp" || base == "cmn")
+        {
+            bool compare = (base == "cmp" || base == "cmn");
+            // add r0, #1 is add r0, r0, #1
+            auto full = ops;
+            if (!compare && full.size() == 2)
+                full.insert(full.begin(), ops[0]);
+            else if (compare)
+                full.insert(full.begin(), "r0");
+            if (full.size() < 3 || full.size() > 4 || !parseReg32(full[0], &rd) || !parseReg32(full[1], &rn))
+                return Status::Unsupported;
+
+            uint32_t op = (base == "add" ? 0x00800000 : (base == "sub" ? 0x00400000 : (base == "cmp" ? 0x01500000 : 0x01700000)));
+            if (compare)
+                rd = 0;
+            if (parseNumber(full[2], &imm))
+            {
+                if (full.size() != 3 || imm < INT32_MIN || imm > UINT32_MAX)
+                    return Status::Unsupported;
+                uint32_t value = imm;
+                if (armImmediate(value, &encoded))
+                    return emit32(cond | 0x02000000 | op | flags | rn << 16 | rd << 12 | encoded, out);
+                // add #-1 is sub #1, cmp #-1 is cmn #1
+                if (armImmediate(-value, &encoded))
+                    return emit32(cond | 0x02000000 | (compare ? op ^ 0x00200000 : op ^ 0x00C00000) | flags | rn << 16 | rd << 12 | encoded, out);
+                return fail("immediate can't be encoded", out);
+            }
+
+            uint32_t type = 0;
+            int64_t amount = 0;
+            if (!parseReg32(full[2], &rm) || (full.size() == 4 && !parseShift(full[3], &type, &amount)))
+                return Status::Unsupported;
+            if (amount < 0 || amount > 31)
+                return fail("shift out of range", out);
+            return emit32(cond | op | flags | rn << 16 | rd << 12 | amount << 7 | type << 5 | rm, out);
+        }
+
+        for (auto &ls : LOAD_STORE32)
+        {
+            if (base == ls.mnemonic)
+                return loadStore32(ls, cond >> 28, false, ops, address, out);
+        }
+        return Status::Unsupported;
+    }
+
+    static Status assembleThumb(const std::string &mn, const std::vector<std::string> &ops, uint64_t address, std::string *out)
+    {
+        std::string base;
+        bool s;
+        uint32_t cond, rd, rn, rm, encoded;
+        int64_t imm;
+        if (!splitMnemonic32(mn, &base, &s, &cond))
+            return Status::Unsupported;
+        bool wide = (mn.size() > 2 && mn.compare(mn.size() - 2, 2, ".w") == 0);
+
+        // only branches can be conditional outside an IT block
+        if (cond != 0xE && base != "b")
+            return Status::Unsupported;
+
+        if (base == "nop")
+            return (ops.empty() ? (wide ? emitThumb2(0xF3AF, 0x8000, out) : emitThumb(0xBF00, out)) : Status::Unsupported);
+
+        if (base == "bx")
+            return (ops.size() == 1 && parseReg32(ops[0], &rm) ? emitThumb(0x4700 | rm << 3, out) : Status::Unsupported);
+
+        if (base == "b" || base == "bl")
+        {
+            uint64_t target;
+            if (ops.size() != 1 || !parseTarget(ops[0], &target))
+                return Status::Unsupported;
+            int64_t delta = target - (address + 4);
+            if (delta & 1)
+                return fail("branch target isn't aligned", out);
+
+            // the 16-bit forms when they reach, as an assembler would relax to
+            if (base == "b" && !wide && cond == 0xE && inRange(delta >> 1, 11))
+                return emitThumb(0xE000 | ((delta >> 1) & 0x7FF), out);
+            if (base == "b" && !wide && cond != 0xE && inRange(delta >> 1, 8))
+                return emitThumb(0xD000 | cond << 8 | ((delta >> 1) & 0xFF), out);
+
+            uint32_t sign = (delta < 0);
+            if (base == "b" && cond != 0xE)
+            {
+                if (!inRange(delta >> 1, 20))
+                    return fail("branch target out of range", out);
+                uint32_t j1 = (delta >> 18) & 1, j2 = (delta >> 19) & 1;
+                return emitThumb2(0xF000 | sign << 10 | cond << 6 | ((delta >> 12) & 0x3F), 0x8000 | j1 << 13 | j2 << 11 | ((delta >> 1) & 0x7FF), out);
+            }
+            if (!inRange(delta >> 1, 24))
+                return fail("branch target out of range", out);
+            uint32_t j1 = (((delta >> 23) & 1) ^ 1) ^ sign, j2 = (((delta >> 22) & 1) ^ 1) ^ sign;
+            return emitThumb2(0xF000 | sign << 10 | ((delta >> 12) & 0x3FF), (base == "bl" ? 0xD000 : 0x9000) | j1 << 13 | j2 << 11 | ((delta >> 1) & 0x7FF), out);
+        }
+
+        if (base == "cbz" || base == "cbnz")
+        {
+            uint64_t target;
+            if (ops.size() != 2 || !parseReg32(ops[0], &rn) || !parseTarget(ops[1], &target))
+                return Status::Unsupported;
+            int64_t delta = target - (address + 4);
+            if (rn > 7)
+                return fail("register must be r0-r7", out);
+            if (delta < 0 || delta > 126 || (delta & 1))
+                return fail("branch target out of range", out);
+            return emitThumb((base == "cbz" ? 0xB100 : 0xB900) | (delta >> 6) << 9 | ((delta >> 1) & 0x1F) << 3 | rn, out);
+        }
+
+        if (base == "movw" || base == "movt")
+        {
+            if (ops.size() != 2 || !parseReg32(ops[0], &rd) || !parseNumber(ops[1], &imm))
+                return Status::Unsupported;
+            if (imm < 0 || imm > 0xFFFF)
+                return fail("immediate out of range", out);
+            if (isSpOrPc(rd))
+                return Status::Unsupported;
+            uint32_t first = (base == "movw" ? 0xF240 : 0xF2C0) | (imm >> 12);
+            uint32_t second = thumbSplit(imm & 0xFFF, &first) | rd << 8;
+            return emitThumb2(first, second, out);
+        }
+
+        if (base == "mov" || base == "mvn")
+        {
+            if (ops.size() != 2 || !parseReg32(ops[0], &rd))
+                return Status::Unsupported;
+            if (parseReg32(ops[1], &rm))
+            {
+                if (base == "mov" && !s && !wide)
+                    return emitThumb(0x4600 | (rd >> 3) << 7 | rm << 3 | (rd & 7), out);
+                if (base == "mov" && s && !wide && rd < 8 && rm < 8)
+                    return emitThumb(rm << 3 | rd, out);
+                if (base == "mvn" && s && !wide && rd < 8 && rm < 8)
+                    return emitThumb(0x43C0 | rm << 3 | rd, out);
+                if (isSpOrPc(rd) || isSpOrPc(rm))
+                    return Status::Unsupported;
+                return emitThumb2((base == "mov" ? 0xEA4F : 0xEA6F) | s << 4, rd << 8 | rm, out);
+            }
+            if (!parseNumber(ops[1], &imm) || imm < INT32_MIN || imm > UINT32_MAX)
+                return Status::Unsupported;
+
+            // the choices below follow LLVM: MOV takes MOVW for 16-bit values over a byte, and MOV, MVN
+            // and MVNS (but not MOVS or .w) swap to the opposite instruction when only the complement
+            // can be encoded, MVNS becoming the 16-bit MOVS if it fits
+            bool mvn = (base == "mvn");
+            uint32_t value = imm;
+            if (!mvn && s && !wide && rd < 8 && value <= 0xFF)
+                return emitThumb(0x2000 | rd << 8 | value, out);
+            if (isSpOrPc(rd))
+                return Status::Unsupported;
+            if (!mvn && !s && !wide && value > 0xFF && value <= 0xFFFF)
+            {
+                uint32_t first = 0xF240 | (value >> 12);
+                uint32_t second = thumbSplit(value & 0xFFF, &first) | rd << 8;
+                return emitThumb2(first, second, out);
+            }
+            uint32_t op = (mvn ? 0xF06F : 0xF04F);
+            if (!thumbImmediate(value, &encoded))
+            {
+                if (wide || (s && !mvn))
+                    return fail("immediate can't be encoded", out);
+                op ^= 0x0020;
+                value = ~value;
+                if (s && rd < 8 && value <= 0xFF)
+                    return emitThumb(0x2000 | rd << 8 | value, out);
+                if (!thumbImmediate(value, &encoded))
+                    return fail("immediate can't be encoded", out);
+            }
+            uint32_t first = op | s << 4;
+            uint32_t second = thumbSplit(encoded, &first) | rd << 8;
+            return emitThumb2(first, second, out);
+        }
+
+        if (base == "add" || base == "sub" || base == "cmp" || base == "cmn")
+        {
+            bool compare = (base == "cmp" || base == "cmn");
+            bool add = (base == "add" || base == "cmn");
+            bool twoOperand = (!compare && ops.size() == 2);
+            auto full = ops;
+            if (twoOperand)
+                full.insert(full.begin(), ops[0]);
+            else if (compare)
+                full.insert(full.begin(), "pc");
+            if (full.size() != 3 || !parseReg32(full[0], &rd) || !parseReg32(full[1], &rn))
+                return Status::Unsupported;
+            // Rn = PC is ADR, and SP can only be written from SP
+            if (rn == 15 || (!compare && (rd == 15 || (rd == 13 && rn != 13))))
+                return Status::Unsupported;
+            if (compare)
+            {
+                s = true;
+                rd = 15;
+            }
+
+            if (parseNumber(full[2], &imm))
+            {
+                if (imm < INT32_MIN || imm > UINT32_MAX)
+                    return fail("immediate out of range", out);
+                // the opposite operation takes the magnitude of a negative value
+                bool negative = (imm < 0);
+                uint32_t value = imm;
+                uint32_t magnitude = (negative ? -value : value);
+                bool flipped = (negative ? !add : add);
+                // as in LLVM, SUB with two operands never swaps, and ADDS with two operands only
+                // swaps when the value can't be encoded as it is
+                bool direct = thumbImmediate(value, &encoded);
+                if (twoOperand && !add && negative && !direct)
+                    return fail("immediate can't be encoded", out);
+
+                // narrow forms first
+                if (!wide && base == "cmp" && !negative && rn < 8 && value <= 0xFF)
+                    return emitThumb(0x2800 | rn << 8 | value, out);
+                if (!wide && !compare && !twoOperand && s && rd < 8 && rn < 8 && magnitude <= 7)
+                    return emitThumb((flipped ? 0x1C00 : 0x1E00) | magnitude << 6 | rn << 3 | rd, out);
+                if (!wide && !compare && s && rd == rn && rd < 8 && magnitude <= 0xFF && !(negative && twoOperand && direct))
+                    return emitThumb((flipped ? 0x3000 : 0x3800) | rd << 8 | magnitude, out);
+                if (!wide && !compare && !s && rd == 13 && rn == 13 && magnitude % 4 == 0 && magnitude <= 508)
+                    return emitThumb((flipped ? 0xB000 : 0xB080) | magnitude / 4, out);
+                if (!wide && !compare && !s && rd < 8 && rn == 13 && !negative && value % 4 == 0 && value <= 1020)
+                    return emitThumb(0xA800 | rd << 8 | value / 4, out);
+
+                // CMP and CMN only swap without .w and not for SP, ADDW and SUBW can't be asked for with .w
+                uint32_t first;
+                if (thumbImmediate(value, &encoded))
+                    first = (add ? 0xF100 : 0xF1A0) | s << 4 | rn;
+                else if (negative && !(compare && (wide || rn == 13)) && thumbImmediate(magnitude, &encoded))
+                    first = (flipped ? 0xF100 : 0xF1A0) | s << 4 | rn;
+                else if (!s && !wide && magnitude <= 0xFFF)
+                {
+                    // ADDW and SUBW take a plain 12-bit value
+                    encoded = magnitude;
+                    first = (flipped ? 0xF200 : 0xF2A0) | rn;
+                }
+                else
+                    return fail("immediate can't be encoded", out);
+                uint32_t second = thumbSplit(encoded, &first) | rd << 8;
+                return emitThumb2(first, second, out);
+            }
+
+            if (!parseReg32(full[2], &rm))
+                return Status::Unsupported;
+            if (!wide && compare && base == "cmp" && rn < 8 && rm < 8)
+                return emitThumb(0x4280 | rm << 3 | rn, out);
+            if (!wide && base == "cmn" && rn < 8 && rm < 8)
+                return emitThumb(0x42C0 | rm << 3 | rn, out);
+            if (!wide && compare && base == "cmp")
+                return emitThumb(0x4500 | (rn >> 3) << 7 | rm << 3 | (rn & 7), out);
+            if (!wide && !compare && s && rd < 8 && rn < 8 && rm < 8)
+                return emitThumb((add ? 0x1800 : 0x1A00) | rm << 6 | rn << 3 | rd, out);
+            if (!wide && !compare && !s && add && rd == rn)
+                return emitThumb(0x4400 | (rd >> 3) << 7 | rm << 3 | (rd & 7), out);
+            if (!wide && !compare && !s && add && rd == rm)
+                return emitThumb(0x4400 | (rd >> 3) << 7 | rn << 3 | (rd & 7), out);
+            if (isSpOrPc(rm))
+                return Status::Unsupported;
+            return emitThumb2((add ? 0xEB00 : 0xEBA0) | s << 4 | rn, rd << 8 | rm, out);
+        }
+
+        for (auto &ls : LOAD_STORE32)
+        {
+            if (base == ls.mnemonic)
+                return (wide ? Status::Unsupported : loadStore32(ls, cond, true, ops, address, out));
+        }
+        return Status::Unsupported;
+    }
+
+    Status assemble(requests::Arch arch, const std::string &line, uint64_t address, std::string *out)
+    {
+        // lower case, without comments
+        std::string text;
+        for (char c : line)
+        {
+            if (c == ';' || c == '@')
+                break;
+            text += tolower(static_cast<unsigned char>(c));
+        }
+        size_t comment = text.find("//");
+        if (comment != std::string::npos)
+            text.erase(comment);
+        text = trim(text);
+        if (text.empty())
+            return Status::Unsupported;
+
+        size_t split = text.find_first_of(" \t");
+        std::string mnemonic = text.substr(0, split);
+        auto operands = splitOperands(split == std::string::npos ? "" : text.substr(split));
+
+        switch (arch)
+        {
+        case requests::Arch::Arm64:
+            return assemble64(mnemonic, operands, address, out);
+        case requests::Arch::Arm:
+            return assembleArm(mnemonic, operands, address, out);
+        case requests::Arch::Thumb:
+            return assembleThumb(mnemonic, operands, address, out);
+        }
+        return Status::Unsupported;
+    }
+} // namespace arm
@@ -0,0 +1,20 @@
+#pragma once
+#include "arch.hpp"
+#include <cstdint>
+#include <string>
+
+namespace arm
+{
+    enum class Status
+    {
+        Ok,
+        Error,          // a supported instruction which can't be encoded (e.g. immediate out of range)
+        Unsupported,    // outside the subset handled here, the API has to be asked instead
+    };
+
+    // Assembles one instruction at address without the network. The subset is what patches mostly use:
+    // NOP, MOV/MOVZ/MOVN/MOVK/MOVW/MOVT, ADD/SUB/CMP/CMN, B/BL/B.cond/CBZ/CBNZ, RET/BR/BLR/BX,
+    // LDR/STR (and byte, halfword and unscaled variants) and FMOV (ARM64).
+    // out is set to the hex the API would give (bytes in memory order) or to the error.
+    Status assemble(requests::Arch arch, const std::string &line, uint64_t address, std::string *out);
+} // namespace arm
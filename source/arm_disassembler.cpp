@@ -0,0 +1,1047 @@
+#include "arm_disassembler.hpp"
+#include <cstdio>
+
+namespace arm
+{
+    enum class Format : uint8_t
+    {
+        Hint,
+        Return,
+        BranchRegister,
+        Exception,
+        Branch,
+        BranchCond,
+        CompareBranch,
+        TestBranch,
+        MoveWide,
+        AddSubImmediate,
+        AddSubRegister,
+        LogicalImmediate,
+        LogicalRegister,
+        Bitfield,
+        Address,
+        MultiplyAdd,
+        DataProcessing2,
+        ConditionalSelect,
+        LoadStoreUnsigned,
+        LoadStoreIndexed,
+        LoadStoreRegister,
+        LoadLiteral,
+        LoadStorePair,
+        FmovRegister,
+        FmovGeneral,
+        FmovImmediate,
+        FloatArithmetic,
+        FloatCompare,
+    };
+
+    struct Pattern
+    {
+        uint32_t mask;
+        uint32_t value;
+        Format format;
+        const char *mnemonic; // only for the formats with a single mnemonic
+    };
+
+    // the first pattern that matches decides, so more specific ones come first
+    static constexpr Pattern PATTERNS[] = {
+        {0xFFFFF01F, 0xD503201F, Format::Hint, nullptr},
+        {0xFFFFFC1F, 0xD65F0000, Format::Return, "ret"},
+        {0xFFFFFC1F, 0xD61F0000, Format::BranchRegister, "br"},
+        {0xFFFFFC1F, 0xD63F0000, Format::BranchRegister, "blr"},
+        {0xFFE0001F, 0xD4000001, Format::Exception, "svc"},
+        {0xFFE0001F, 0xD4200000, Format::Exception, "brk"},
+        {0x7C000000, 0x14000000, Format::Branch, nullptr},
+        {0xFF000010, 0x54000000, Format::BranchCond, nullptr},
+        {0x7E000000, 0x34000000, Format::CompareBranch, nullptr},
+        {0x7E000000, 0x36000000, Format::TestBranch, nullptr},
+        {0x1F800000, 0x12800000, Format::MoveWide, nullptr},
+        {0x1F800000, 0x11000000, Format::AddSubImmediate, nullptr},
+        {0x1F200000, 0x0B000000, Format::AddSubRegister, nullptr},
+        {0x1F800000, 0x12000000, Format::LogicalImmediate, nullptr},
+        {0x1F000000, 0x0A000000, Format::LogicalRegister, nullptr},
+        {0x1F800000, 0x13000000, Format::Bitfield, nullptr},
+        {0x1F000000, 0x10000000, Format::Address, nullptr},
+        {0x7FE00000, 0x1B000000, Format::MultiplyAdd, nullptr},
+        {0x7FE00000, 0x1AC00000, Format::DataProcessing2, nullptr},
+        {0x3FE00800, 0x1A800000, Format::ConditionalSelect, nullptr},
+        {0x3B000000, 0x39000000, Format::LoadStoreUnsigned, nullptr},
+        {0x3B200000, 0x38000000, Format::LoadStoreIndexed, nullptr},
+        {0x3B200C00, 0x38200800, Format::LoadStoreRegister, nullptr},
+        {0x3B000000, 0x18000000, Format::LoadLiteral, nullptr},
+        {0x3A000000, 0x28000000, Format::LoadStorePair, nullptr},
+        {0xFF3FFC00, 0x1E204000, Format::FmovRegister, nullptr},
+        {0xFFFEFC00, 0x1E260000, Format::FmovGeneral, nullptr},
+        {0xFFFEFC00, 0x9E660000, Format::FmovGeneral, nullptr},
+        {0xFF201FE0, 0x1E201000, Format::FmovImmediate, nullptr},
+        {0xFF200C00, 0x1E200800, Format::FloatArithmetic, nullptr},
+        {0xFF20FC07, 0x1E202000, Format::FloatCompare, nullptr},
+    };
+
+    static constexpr size_t PATTERN_COUNT = sizeof(PATTERNS) / sizeof(PATTERNS[0]);
+    static_assert(PATTERN_COUNT < 256, "pattern indices are stored in a byte");
+
+    // op0 (bits 28-25) is the top level instruction group, only the patterns which can match
+    // in a group are tried for it
+    static constexpr size_t GROUP_COUNT = 16;
+    static constexpr uint32_t GROUP_MASK = 0x1E000000;
+    static constexpr uint32_t GROUP_SHIFT = 25;
+
+    struct DecodeTable
+    {
+        uint16_t start[GROUP_COUNT + 1];
+        uint8_t patterns[GROUP_COUNT * PATTERN_COUNT];
+
+        constexpr DecodeTable() : start(), patterns()
+        {
+            size_t count = 0;
+            for (uint32_t group = 0; group < GROUP_COUNT; group++)
+            {
+                start[group] = count;
+                for (size_t i = 0; i < PATTERN_COUNT; i++)
+                {
+                    uint32_t mask = PATTERNS[i].mask & GROUP_MASK;
+                    if (((group << GROUP_SHIFT) & mask) == (PATTERNS[i].value & mask))
+                        patterns[count++] = i;
+                }
+            }
+            start[GROUP_COUNT] = count;
+        }
+    };
+
+    static constexpr DecodeTable DECODE_TABLE;
+
+    static constexpr const char *CONDITIONS[] = {
+        "eq", "ne", "hs", "lo", "mi", "pl", "vs", "vc", "hi", "ls", "ge", "lt", "gt", "le", "al", "nv",
+    };
+
+    static constexpr const char *SHIFTS[] = {"lsl", "lsr", "asr", "ror"};
+
+    static constexpr const char *HINTS[] = {"nop", "yield", "wfe", "wfi", "sev", "sevl"};
+
+    // register kinds for the FP type field, 2 is reserved and 3 (half precision) needs FEAT_FP16,
+    // which the Switch's Cortex-A57 doesn't have, so it is left as .inst like llvm does for the A57
+    static constexpr char FLOAT_KINDS[] = {'s', 'd', '\0', '\0'};
+
+    // single register loads and stores by size:V:opc, kind is 0 for prefetches and reserved encodings
+    struct Access
+    {
+        const char *mnemonic;
+        const char *unscaled;
+        char kind;
+        uint32_t scale; // log2 of the access size
+    };
+
+    static constexpr Access ACCESSES[] = {
+        {"strb", "sturb", 'w', 0}, {"ldrb", "ldurb", 'w', 0}, {"ldrsb", "ldursb", 'x', 0}, {"ldrsb", "ldursb", 'w', 0},
+        {"str", "stur", 'b', 0}, {"ldr", "ldur", 'b', 0}, {"str", "stur", 'q', 4}, {"ldr", "ldur", 'q', 4},
+        {"strh", "sturh", 'w', 1}, {"ldrh", "ldurh", 'w', 1}, {"ldrsh", "ldursh", 'x', 1}, {"ldrsh", "ldursh", 'w', 1},
+        {"str", "stur", 'h', 1}, {"ldr", "ldur", 'h', 1}, {}, {},
+        {"str", "stur", 'w', 2}, {"ldr", "ldur", 'w', 2}, {"ldrsw", "ldursw", 'x', 2}, {},
+        {"str", "stur", 's', 2}, {"ldr", "ldur", 's', 2}, {}, {},
+        {"str", "stur", 'x', 3}, {"ldr", "ldur", 'x', 3}, {}, {},
+        {"str", "stur", 'd', 3}, {"ldr", "ldur", 'd', 3}, {}, {},
+    };
+
+    // PC relative loads by V:opc
+    static constexpr Access LITERALS[] = {
+        {"ldr", nullptr, 'w', 0}, {"ldr", nullptr, 'x', 0}, {"ldrsw", nullptr, 'x', 0}, {},
+        {"ldr", nullptr, 's', 0}, {"ldr", nullptr, 'd', 0}, {"ldr", nullptr, 'q', 0}, {},
+    };
+
+    // register pairs by opc:V, opc 1 without V is LDPSW
+    static constexpr Access PAIRS[] = {
+        {nullptr, nullptr, 'w', 2}, {nullptr, nullptr, 's', 2}, {"ldpsw", nullptr, 'x', 2}, {nullptr, nullptr, 'd', 3},
+        {nullptr, nullptr, 'x', 3}, {nullptr, nullptr, 'q', 4}, {}, {},
+    };
+
+    static constexpr const char *FLOAT_ARITHMETIC[] = {
+        "fmul", "fdiv", "fadd", "fsub", "fmax", "fmin", "fmaxnm", "fminnm", "fnmul",
+    };
+
+    static constexpr const char *DATA_PROCESSING2[] = {
+        nullptr, nullptr, "udiv", "sdiv", nullptr, nullptr, nullptr, nullptr, "lsl", "lsr", "asr", "ror",
+    };
+
+    static constexpr const char *CONDITIONAL_SELECT[] = {"csel", "csinc", "csinv", "csneg"};
+
+    static constexpr uint32_t field(uint32_t word, uint32_t shift, uint32_t size)
+    {
+        return (word >> shift) & ((1u << size) - 1);
+    }
+
+    static constexpr int64_t signExtend(uint64_t value, uint32_t bits)
+    {
+        return static_cast<int64_t>(value << (64 - bits)) >> (64 - bits);
+    }
+
+    // Appends to a fixed buffer, snprintf is far too slow when listing whole code segments
+    class Writer
+    {
+    public:
+        explicit Writer(char *out) : m_start(out), m_pos(out), m_end(out + TEXT_MAX - 1) {}
+
+        void put(char c)
+        {
+            if (m_pos != m_end)
+                *m_pos++ = c;
+        }
+
+        void text(const char *s)
+        {
+            while (*s != '\0' && m_pos != m_end)
+                *m_pos++ = *s++;
+        }
+
+        // mnemonic and the space before the operands
+        void op(const char *mnemonic)
+        {
+            text(mnemonic);
+            put(' ');
+        }
+
+        void separator()
+        {
+            put(',');
+            put(' ');
+        }
+
+        void decimal(uint32_t value)
+        {
+            char digits[10];
+            size_t count = 0;
+            do
+            {
+                digits[count++] = '0' + value % 10;
+                value /= 10;
+            } while (value != 0);
+            while (count != 0)
+                put(digits[--count]);
+        }
+
+        void hex(uint64_t value)
+        {
+            put('0');
+            put('x');
+            int shift = 60;
+            while (shift > 0 && (value >> shift) == 0)
+                shift -= 4;
+            for (; shift >= 0; shift -= 4)
+                put("0123456789abcdef"[(value >> shift) & 0xF]);
+        }
+
+        void immediate(int64_t value)
+        {
+            put('#');
+            if (value < 0)
+            {
+                put('-');
+                hex(0 - static_cast<uint64_t>(value));
+            }
+            else
+                hex(value);
+        }
+
+        // shift amounts, bit positions and widths
+        void amount(uint32_t value)
+        {
+            put('#');
+            decimal(value);
+        }
+
+        // register 31 is the zero register
+        void reg(char kind, uint32_t n)
+        {
+            if (n == 31 && (kind == 'x' || kind == 'w'))
+            {
+                text(kind == 'x' ? "xzr" : "wzr");
+                return;
+            }
+            put(kind);
+            decimal(n);
+        }
+
+        // register 31 is the stack pointer
+        void regSp(bool wide, uint32_t n)
+        {
+            if (n == 31)
+                text(wide ? "sp" : "wsp");
+            else
+                reg(wide ? 'x' : 'w', n);
+        }
+
+        void shift(uint32_t type, uint32_t amount)
+        {
+            if (type == 0 && amount == 0)
+                return;
+            separator();
+            op(SHIFTS[type]);
+            this->amount(amount);
+        }
+
+        void reset()
+        {
+            m_pos = m_start;
+        }
+
+        void finish()
+        {
+            *m_pos = '\0';
+        }
+
+    private:
+        char *m_start;
+        char *m_pos;
+        char *m_end;
+    };
+
+    static bool decodeBitmask(uint32_t n, uint32_t immr, uint32_t imms, bool wide, uint64_t *value)
+    {
+        uint32_t combined = (n << 6) | (~imms & 0x3F);
+        if (combined < 2)
+            return false;
+        uint32_t length = 31 - __builtin_clz(combined);
+        uint32_t size = 1u << length;
+        uint32_t levels = size - 1;
+        uint32_t ones = imms & levels;
+        uint32_t rotate = immr & levels;
+        if (ones == levels)
+            return false;
+
+        uint64_t sizeMask = (size == 64 ? ~UINT64_C(0) : (UINT64_C(1) << size) - 1);
+        uint64_t element = (UINT64_C(1) << (ones + 1)) - 1;
+        if (rotate != 0)
+            element = ((element >> rotate) | (element << (size - rotate))) & sizeMask;
+        for (uint32_t width = size; width < 64; width *= 2)
+            element |= element << width;
+        *value = (wide ? element : element & 0xFFFFFFFF);
+        return true;
+    }
+
+    // MOVZ or MOVN can make the value, so the ORR isn't shown as MOV
+    static bool moveWidePreferred(uint64_t value, bool wide)
+    {
+        uint64_t inverted = (wide ? ~value : ~value & 0xFFFFFFFF);
+        for (uint32_t shift = 0; shift < (wide ? 64u : 32u); shift += 16)
+        {
+            uint64_t chunk = UINT64_C(0xFFFF) << shift;
+            if ((value & ~chunk) == 0 || (inverted & ~chunk) == 0)
+                return true;
+        }
+        return false;
+    }
+
+    static bool moveWide(uint32_t word, Writer *out)
+    {
+        bool wide = field(word, 31, 1);
+        uint32_t opc = field(word, 29, 2);
+        uint32_t hw = field(word, 21, 2);
+        uint32_t imm16 = field(word, 5, 16);
+        uint32_t rd = field(word, 0, 5);
+        if (opc == 1 || (!wide && hw >= 2))
+            return false;
+
+        char kind = (wide ? 'x' : 'w');
+        uint64_t value = static_cast<uint64_t>(imm16) << (hw * 16);
+        bool alias = !(imm16 == 0 && hw != 0);
+        if (opc == 0 && alias && (wide || imm16 != 0xFFFF))
+        {
+            out->op("mov");
+            out->reg(kind, rd);
+            out->separator();
+            out->immediate(wide ? static_cast<int64_t>(~value) : static_cast<int32_t>(~value));
+            return true;
+        }
+        if (opc == 2 && alias)
+        {
+            out->op("mov");
+            out->reg(kind, rd);
+            out->separator();
+            out->immediate(wide ? static_cast<int64_t>(value) : static_cast<int32_t>(value));
+            return true;
+        }
+
+        out->op(opc == 0 ? "movn" : (opc == 2 ? "movz" : "movk"));
+        out->reg(kind, rd);
+        out->separator();
+        out->immediate(imm16);
+        out->shift(0, hw * 16);
+        return true;
+    }
+
+    static bool addSubImmediate(uint32_t word, Writer *out)
+    {
+        bool wide = field(word, 31, 1);
+        bool sub = field(word, 30, 1);
+        bool setFlags = field(word, 29, 1);
+        bool shifted = field(word, 22, 1);
+        uint32_t imm12 = field(word, 10, 12);
+        uint32_t rn = field(word, 5, 5);
+        uint32_t rd = field(word, 0, 5);
+
+        if (!sub && !setFlags && !shifted && imm12 == 0 && (rd == 31 || rn == 31))
+        {
+            out->op("mov");
+            out->regSp(wide, rd);
+            out->separator();
+            out->regSp(wide, rn);
+            return true;
+        }
+
+        if (setFlags && rd == 31)
+            out->op(sub ? "cmp" : "cmn");
+        else
+        {
+            out->op(sub ? (setFlags ? "subs" : "sub") : (setFlags ? "adds" : "add"));
+            if (setFlags)
+                out->reg(wide ? 'x' : 'w', rd);
+            else
+                out->regSp(wide, rd);
+            out->separator();
+        }
+        out->regSp(wide, rn);
+        out->separator();
+        out->immediate(imm12);
+        out->shift(0, shifted ? 12 : 0);
+        return true;
+    }
+
+    static bool addSubRegister(uint32_t word, Writer *out)
+    {
+        bool wide = field(word, 31, 1);
+        bool sub = field(word, 30, 1);
+        bool setFlags = field(word, 29, 1);
+        uint32_t shift = field(word, 22, 2);
+        uint32_t rm = field(word, 16, 5);
+        uint32_t amount = field(word, 10, 6);
+        uint32_t rn = field(word, 5, 5);
+        uint32_t rd = field(word, 0, 5);
+        if (shift == 3 || (!wide && amount >= 32))
+            return false;
+
+        char kind = (wide ? 'x' : 'w');
+        if (setFlags && rd == 31)
+        {
+            out->op(sub ? "cmp" : "cmn");
+            out->reg(kind, rn);
+        }
+        else if (sub && rn == 31)
+        {
+            out->op(setFlags ? "negs" : "neg");
+            out->reg(kind, rd);
+        }
+        else
+        {
+            out->op(sub ? (setFlags ? "subs" : "sub") : (setFlags ? "adds" : "add"));
+            out->reg(kind, rd);
+            out->separator();
+            out->reg(kind, rn);
+        }
+        out->separator();
+        out->reg(kind, rm);
+        out->shift(shift, amount);
+        return true;
+    }
+
+    static bool logicalImmediate(uint32_t word, Writer *out)
+    {
+        bool wide = field(word, 31, 1);
+        uint32_t opc = field(word, 29, 2);
+        uint32_t n = field(word, 22, 1);
+        uint32_t rn = field(word, 5, 5);
+        uint32_t rd = field(word, 0, 5);
+        uint64_t value;
+        if ((!wide && n != 0) || !decodeBitmask(n, field(word, 16, 6), field(word, 10, 6), wide, &value))
+            return false;
+
+        char kind = (wide ? 'x' : 'w');
+        if (opc == 3 && rd == 31)
+            out->op("tst");
+        else if (opc == 1 && rn == 31 && !moveWidePreferred(value, wide))
+        {
+            out->op("mov");
+            out->regSp(wide, rd);
+            out->separator();
+            out->immediate(wide ? static_cast<int64_t>(value) : static_cast<int32_t>(value));
+            return true;
+        }
+        else
+        {
+            static constexpr const char *MNEMONICS[] = {"and", "orr", "eor", "ands"};
+            out->op(MNEMONICS[opc]);
+            if (opc == 3)
+                out->reg(kind, rd);
+            else
+                out->regSp(wide, rd);
+            out->separator();
+        }
+        out->reg(kind, rn);
+        out->separator();
+        // a bit pattern, so never negative (the mov alias above is a value, so it can be)
+        out->put('#');
+        out->hex(value);
+        return true;
+    }
+
+    static bool logicalRegister(uint32_t word, Writer *out)
+    {
+        static constexpr const char *MNEMONICS[] = {"and", "bic", "orr", "orn", "eor", "eon", "ands", "bics"};
+
+        bool wide = field(word, 31, 1);
+        uint32_t opc = field(word, 29, 2);
+        uint32_t shift = field(word, 22, 2);
+        uint32_t negate = field(word, 21, 1);
+        uint32_t rm = field(word, 16, 5);
+        uint32_t amount = field(word, 10, 6);
+        uint32_t rn = field(word, 5, 5);
+        uint32_t rd = field(word, 0, 5);
+        if (!wide && amount >= 32)
+            return false;
+
+        char kind = (wide ? 'x' : 'w');
+        if (opc == 1 && rn == 31 && (negate || (shift == 0 && amount == 0)))
+        {
+            out->op(negate ? "mvn" : "mov");
+            out->reg(kind, rd);
+        }
+        else if (opc == 3 && !negate && rd == 31)
+        {
+            out->op("tst");
+            out->reg(kind, rn);
+        }
+        else
+        {
+            out->op(MNEMONICS[opc * 2 + negate]);
+            out->reg(kind, rd);
+            out->separator();
+            out->reg(kind, rn);
+        }
+        out->separator();
+        out->reg(kind, rm);
+        out->shift(shift, amount);
+        return true;
+    }
+
+    static bool bitfield(uint32_t word, Writer *out)
+    {
+        bool wide = field(word, 31, 1);
+        uint32_t opc = field(word, 29, 2);
+        uint32_t immr = field(word, 16, 6);
+        uint32_t imms = field(word, 10, 6);
+        uint32_t rn = field(word, 5, 5);
+        uint32_t rd = field(word, 0, 5);
+        if (opc == 3 || field(word, 22, 1) != static_cast<uint32_t>(wide) || (!wide && (immr >= 32 || imms >= 32)))
+            return false;
+
+        char kind = (wide ? 'x' : 'w');
+        uint32_t width = (wide ? 64 : 32);
+
+        // sign and zero extensions read a W register
+        const char *extend = nullptr;
+        if (immr == 0 && opc == 0)
+            extend = (imms == 7 ? "sxtb" : (imms == 15 ? "sxth" : (imms == 31 && wide ? "sxtw" : nullptr)));
+        else if (immr == 0 && opc == 2 && !wide)
+            extend = (imms == 7 ? "uxtb" : (imms == 15 ? "uxth" : nullptr));
+        if (extend != nullptr)
+        {
+            out->op(extend);
+            out->reg(kind, rd);
+            out->separator();
+            out->reg('w', rn);
+            return true;
+        }
+
+        // lsb and width operands of the insert and extract aliases
+        uint32_t first = immr;
+        uint32_t second = imms - immr + 1;
+        const char *mnemonic;
+        if (opc != 1 && imms == width - 1)
+        {
+            mnemonic = (opc == 0 ? "asr" : "lsr");
+            second = 0;
+        }
+        else if (opc == 2 && imms + 1 == immr)
+        {
+            mnemonic = "lsl";
+            first = width - immr;
+            second = 0;
+        }
+        else if (imms < immr)
+        {
+            mnemonic = (opc == 0 ? "sbfiz" : (opc == 1 ? (rn == 31 ? "bfc" : "bfi") : "ubfiz"));
+            first = width - immr;
+            second = imms + 1;
+        }
+        else
+            mnemonic = (opc == 0 ? "sbfx" : (opc == 1 ? "bfxil" : "ubfx"));
+
+        out->op(mnemonic);
+        out->reg(kind, rd);
+        if (opc != 1 || rn != 31 || imms >= immr)
+        {
+            out->separator();
+            out->reg(kind, rn);
+        }
+        out->separator();
+        out->amount(first);
+        if (second != 0)
+        {
+            out->separator();
+            out->amount(second);
+        }
+        return true;
+    }
+
+    static bool conditionalSelect(uint32_t word, Writer *out)
+    {
+        bool wide = field(word, 31, 1);
+        uint32_t index = field(word, 30, 1) * 2 + field(word, 10, 1);
+        uint32_t rm = field(word, 16, 5);
+        uint32_t cond = field(word, 12, 4);
+        uint32_t rn = field(word, 5, 5);
+        uint32_t rd = field(word, 0, 5);
+        char kind = (wide ? 'x' : 'w');
+
+        // the aliases take the inverted condition and are only used while it isn't AL/NV
+        if (index != 0 && rn == rm && cond < 14)
+        {
+            out->op(rn == 31 && index != 3 ? (index == 1 ? "cset" : "csetm") : (index == 1 ? "cinc" : (index == 2 ? "cinv" : "cneg")));
+            out->reg(kind, rd);
+            if (rn != 31 || index == 3)
+            {
+                out->separator();
+                out->reg(kind, rn);
+            }
+            out->separator();
+            out->text(CONDITIONS[cond ^ 1]);
+            return true;
+        }
+
+        out->op(CONDITIONAL_SELECT[index]);
+        out->reg(kind, rd);
+        out->separator();
+        out->reg(kind, rn);
+        out->separator();
+        out->reg(kind, rm);
+        out->separator();
+        out->text(CONDITIONS[cond]);
+        return true;
+    }
+
+    // [Xn|SP, #offset], [Xn|SP], #offset or [Xn|SP, #offset]! for index 0, 1 and 3
+    static void memory(uint32_t rn, int64_t offset, uint32_t index, Writer *out)
+    {
+        out->put('[');
+        out->regSp(true, rn);
+        if (index == 1)
+        {
+            out->put(']');
+            out->separator();
+            out->immediate(offset);
+            return;
+        }
+        if (offset != 0 || index == 3)
+        {
+            out->separator();
+            out->immediate(offset);
+        }
+        out->put(']');
+        if (index == 3)
+            out->put('!');
+    }
+
+    static const Access *access(uint32_t word)
+    {
+        const Access &access = ACCESSES[field(word, 30, 2) * 8 + field(word, 26, 1) * 4 + field(word, 22, 2)];
+        return (access.kind == '\0' ? nullptr : &access);
+    }
+
+    static bool loadStore(Format format, uint32_t word, Writer *out)
+    {
+        const Access *acc = access(word);
+        if (acc == nullptr)
+            return false;
+        uint32_t rn = field(word, 5, 5);
+        uint32_t rt = field(word, 0, 5);
+
+        if (format == Format::LoadStoreUnsigned)
+        {
+            out->op(acc->mnemonic);
+            out->reg(acc->kind, rt);
+            out->separator();
+            memory(rn, static_cast<int64_t>(field(word, 10, 12)) << acc->scale, 0, out);
+            return true;
+        }
+
+        if (format == Format::LoadStoreIndexed)
+        {
+            // 2 is the unprivileged LDTR/STTR family
+            uint32_t index = field(word, 10, 2);
+            if (index == 2)
+                return false;
+            out->op(index == 0 ? acc->unscaled : acc->mnemonic);
+            out->reg(acc->kind, rt);
+            out->separator();
+            memory(rn, signExtend(field(word, 12, 9), 9), index, out);
+            return true;
+        }
+
+        // register offset, option bit 1 clear is reserved and bit 0 picks an X index register
+        uint32_t option = field(word, 13, 3);
+        bool scaled = field(word, 12, 1);
+        if ((option & 2) == 0)
+            return false;
+        out->op(acc->mnemonic);
+        out->reg(acc->kind, rt);
+        out->separator();
+        out->put('[');
+        out->regSp(true, rn);
+        out->separator();
+        out->reg((option & 1) ? 'x' : 'w', field(word, 16, 5));
+        if (option != 3 || scaled)
+        {
+            static constexpr const char *EXTENDS[] = {nullptr, nullptr, "uxtw", "lsl", nullptr, nullptr, "sxtw", "sxtx"};
+            out->separator();
+            out->text(EXTENDS[option]);
+            if (scaled)
+            {
+                out->put(' ');
+                out->amount(acc->scale);
+            }
+        }
+        out->put(']');
+        return true;
+    }
+
+    static bool loadLiteral(uint32_t word, uint64_t address, Writer *out)
+    {
+        const Access &acc = LITERALS[field(word, 26, 1) * 4 + field(word, 30, 2)];
+        if (acc.kind == '\0')
+            return false;
+        out->op(acc.mnemonic);
+        out->reg(acc.kind, field(word, 0, 5));
+        out->separator();
+        out->hex(address + (signExtend(field(word, 5, 19), 19) << 2));
+        return true;
+    }
+
+    static bool loadStorePair(uint32_t word, Writer *out)
+    {
+        const Access &acc = PAIRS[field(word, 30, 2) * 2 + field(word, 26, 1)];
+        uint32_t index = field(word, 23, 2);
+        bool load = field(word, 22, 1);
+        if (acc.kind == '\0')
+            return false;
+        // LDPSW has no store or non-temporal form
+        if (acc.mnemonic != nullptr && (!load || index == 0))
+            return false;
+
+        if (acc.mnemonic != nullptr)
+            out->op(acc.mnemonic);
+        else if (index == 0)
+            out->op(load ? "ldnp" : "stnp");
+        else
+            out->op(load ? "ldp" : "stp");
+        out->reg(acc.kind, field(word, 0, 5));
+        out->separator();
+        out->reg(acc.kind, field(word, 10, 5));
+        out->separator();
+        memory(field(word, 5, 5), signExtend(field(word, 15, 7), 7) << acc.scale, index == 2 ? 0 : index, out);
+        return true;
+    }
+
+    static bool floatingPoint(Format format, uint32_t word, Writer *out)
+    {
+        char kind = FLOAT_KINDS[field(word, 22, 2)];
+        uint32_t rm = field(word, 16, 5);
+        uint32_t rn = field(word, 5, 5);
+        uint32_t rd = field(word, 0, 5);
+        if (kind == '\0')
+            return false;
+
+        switch (format)
+        {
+        case Format::FmovRegister:
+            out->op("fmov");
+            out->reg(kind, rd);
+            out->separator();
+            out->reg(kind, rn);
+            return true;
+
+        case Format::FmovImmediate:
+        {
+            // +/-(16 + m) / 16 * 2^e with a 3-bit exponent, same as the assembler's table
+            uint32_t imm8 = field(word, 13, 8);
+            int exponent = static_cast<int>(((imm8 >> 4) & 7) ^ 4) - 3;
+            double value = (16 + (imm8 & 0xF)) / 16.0;
+            value = (exponent >= 0 ? value * (1 << exponent) : value / (1 << -exponent));
+            char number[24];
+            snprintf(number, sizeof(number), "%.8f", (imm8 & 0x80) ? -value : value);
+            out->op("fmov");
+            out->reg(kind, rd);
+            out->separator();
+            out->put('#');
+            out->text(number);
+            return true;
+        }
+
+        case Format::FloatArithmetic:
+        {
+            uint32_t opcode = field(word, 12, 4);
+            if (opcode >= sizeof(FLOAT_ARITHMETIC) / sizeof(FLOAT_ARITHMETIC[0]))
+                return false;
+            out->op(FLOAT_ARITHMETIC[opcode]);
+            out->reg(kind, rd);
+            out->separator();
+            out->reg(kind, rn);
+            out->separator();
+            out->reg(kind, rm);
+            return true;
+        }
+
+        case Format::FloatCompare:
+            out->op(field(word, 4, 1) ? "fcmpe" : "fcmp");
+            out->reg(kind, rn);
+            out->separator();
+            if (field(word, 3, 1))
+                out->text("#0.0");
+            else
+                out->reg(kind, rm);
+            return true;
+
+        default:
+            return false;
+        }
+    }
+
+    static bool decode(const Pattern &pattern, uint32_t word, uint64_t address, Writer *out)
+    {
+        switch (pattern.format)
+        {
+        case Format::Hint:
+        {
+            uint32_t hint = field(word, 5, 7);
+            if (hint < sizeof(HINTS) / sizeof(HINTS[0]))
+                out->text(HINTS[hint]);
+            else
+            {
+                out->op("hint");
+                out->amount(hint);
+            }
+            return true;
+        }
+
+        case Format::Return:
+            out->text(pattern.mnemonic);
+            if (field(word, 5, 5) != 30)
+            {
+                out->put(' ');
+                out->reg('x', field(word, 5, 5));
+            }
+            return true;
+
+        case Format::BranchRegister:
+            out->op(pattern.mnemonic);
+            out->reg('x', field(word, 5, 5));
+            return true;
+
+        case Format::Exception:
+            out->op(pattern.mnemonic);
+            out->immediate(field(word, 5, 16));
+            return true;
+
+        case Format::Branch:
+            out->op(field(word, 31, 1) ? "bl" : "b");
+            out->hex(address + (signExtend(field(word, 0, 26), 26) << 2));
+            return true;
+
+        case Format::BranchCond:
+            out->text("b.");
+            out->op(CONDITIONS[field(word, 0, 4)]);
+            out->hex(address + (signExtend(field(word, 5, 19), 19) << 2));
+            return true;
+
+        case Format::CompareBranch:
+            out->op(field(word, 24, 1) ? "cbnz" : "cbz");
+            out->reg(field(word, 31, 1) ? 'x' : 'w', field(word, 0, 5));
+            out->separator();
+            out->hex(address + (signExtend(field(word, 5, 19), 19) << 2));
+            return true;
+
+        case Format::TestBranch:
+            out->op(field(word, 24, 1) ? "tbnz" : "tbz");
+            out->reg(field(word, 31, 1) ? 'x' : 'w', field(word, 0, 5));
+            out->separator();
+            out->amount(field(word, 31, 1) << 5 | field(word, 19, 5));
+            out->separator();
+            out->hex(address + (signExtend(field(word, 5, 14), 14) << 2));
+            return true;
+
+        case Format::MoveWide:
+            return moveWide(word, out);
+
+        case Format::AddSubImmediate:
+            return addSubImmediate(word, out);
+
+        case Format::AddSubRegister:
+            return addSubRegister(word, out);
+
+        case Format::LogicalImmediate:
+            return logicalImmediate(word, out);
+
+        case Format::LogicalRegister:
+            return logicalRegister(word, out);
+
+        case Format::Bitfield:
+            return bitfield(word, out);
+
+        case Format::Address:
+        {
+            int64_t offset = signExtend(field(word, 5, 19) << 2 | field(word, 29, 2), 21);
+            bool page = field(word, 31, 1);
+            out->op(page ? "adrp" : "adr");
+            out->reg('x', field(word, 0, 5));
+            out->separator();
+            out->hex(page ? (address & ~UINT64_C(0xFFF)) + (offset << 12) : address + offset);
+            return true;
+        }
+
+        case Format::MultiplyAdd:
+        {
+            bool wide = field(word, 31, 1);
+            bool subtract = field(word, 15, 1);
+            uint32_t ra = field(word, 10, 5);
+            char kind = (wide ? 'x' : 'w');
+            out->op(ra == 31 ? (subtract ? "mneg" : "mul") : (subtract ? "msub" : "madd"));
+            out->reg(kind, field(word, 0, 5));
+            out->separator();
+            out->reg(kind, field(word, 5, 5));
+            out->separator();
+            out->reg(kind, field(word, 16, 5));
+            if (ra != 31)
+            {
+                out->separator();
+                out->reg(kind, ra);
+            }
+            return true;
+        }
+
+        case Format::DataProcessing2:
+        {
+            uint32_t opcode = field(word, 10, 6);
+            if (opcode >= sizeof(DATA_PROCESSING2) / sizeof(DATA_PROCESSING2[0]) || DATA_PROCESSING2[opcode] == nullptr)
+                return false;
+            char kind = (field(word, 31, 1) ? 'x' : 'w');
+            out->op(DATA_PROCESSING2[opcode]);
+            out->reg(kind, field(word, 0, 5));
+            out->separator();
+            out->reg(kind, field(word, 5, 5));
+            out->separator();
+            out->reg(kind, field(word, 16, 5));
+            return true;
+        }
+
+        case Format::ConditionalSelect:
+            return conditionalSelect(word, out);
+
+        case Format::LoadStoreUnsigned:
+        case Format::LoadStoreIndexed:
+        case Format::LoadStoreRegister:
+            return loadStore(pattern.format, word, out);
+
+        case Format::LoadLiteral:
+            return loadLiteral(word, address, out);
+
+        case Format::LoadStorePair:
+            return loadStorePair(word, out);
+
+        case Format::FmovGeneral:
+        {
+            bool wide = field(word, 31, 1);
+            char general = (wide ? 'x' : 'w');
+            char fp = (wide ? 'd' : 's');
+            bool toFloat = field(word, 16, 1);
+            out->op("fmov");
+            out->reg(toFloat ? fp : general, field(word, 0, 5));
+            out->separator();
+            out->reg(toFloat ? general : fp, field(word, 5, 5));
+            return true;
+        }
+
+        default:
+            return floatingPoint(pattern.format, word, out);
+        }
+    }
+
+    bool disassemble(uint32_t word, uint64_t address, char *out)
+    {
+        Writer writer(out);
+        uint32_t group = (word & GROUP_MASK) >> GROUP_SHIFT;
+        for (size_t i = DECODE_TABLE.start[group]; i < DECODE_TABLE.start[group + 1]; i++)
+        {
+            const Pattern &pattern = PATTERNS[DECODE_TABLE.patterns[i]];
+            if ((word & pattern.mask) != pattern.value)
+                continue;
+            if (decode(pattern, word, address, &writer))
+            {
+                writer.finish();
+                return true;
+            }
+            // reserved field values, nothing after the first match can decode it either
+            writer.reset();
+            break;
+        }
+
+        writer.op(".inst");
+        writer.hex(word);
+        writer.finish();
+        return false;
+    }
+
+    std::string disassemble(uint32_t word, uint64_t address)
+    {
+        char text[TEXT_MAX];
+        disassemble(word, address, text);
+        return text;
+    }
+
+    void disassemble(const uint8_t *data, size_t size, uint64_t address, const LineCallback &callback)
+    {
+        char text[TEXT_MAX];
+        for (size_t i = 0; i + 4 <= size; i += 4, address += 4)
+        {
+            uint32_t word = data[i] | data[i + 1] << 8 | data[i + 2] << 16 | static_cast<uint32_t>(data[i + 3]) << 24;
+            disassemble(word, address, text);
+            callback(address, word, text);
+        }
+    }
+
+    static int hexValue(char c)
+    {
+        if (c >= '0' && c <= '9')
+            return c - '0';
+        if (c >= 'a' && c <= 'f')
+            return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F')
+            return c - 'A' + 10;
+        return -1;
+    }
+
+    bool parseHex(const std::string &hex, std::vector<uint8_t> *bytes)
+    {
+        if (hex.size() % 2 != 0)
+            return false;
+
+        bytes->clear();
+        bytes->reserve(hex.size() / 2);
+        for (size_t i = 0; i < hex.size(); i += 2)
+        {
+            int high = hexValue(hex[i]);
+            int low = hexValue(hex[i + 1]);
+            if (high < 0 || low < 0)
+                return false;
+            bytes->push_back(high << 4 | low);
+        }
+        return true;
+    }
+} // namespace arm
@@ -0,0 +1,26 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace arm
+{
+    // longest line disassemble() writes, including the terminator
+    static constexpr size_t TEXT_MAX = 64;
+
+    using LineCallback = std::function<void(uint64_t address, uint32_t word, const char *text)>;
+
+    // Disassembles one ARM64 instruction at address into out (TEXT_MAX bytes) without allocating.
+    // Covers the integer, branch, load/store and common FP instructions, anything else is written
+    // as ".inst 0x..." and false is returned.
+    bool disassemble(uint32_t word, uint64_t address, char *out);
+    std::string disassemble(uint32_t word, uint64_t address);
+
+    // Disassembles the little endian instructions in data, a trailing partial word is ignored
+    void disassemble(const uint8_t *data, size_t size, uint64_t address, const LineCallback &callback);
+
+    // Bytes from hex as the assembler gives it (memory order), false if it isn't whole bytes of hex
+    bool parseHex(const std::string &hex, std::vector<uint8_t> *bytes);
+} // namespace arm
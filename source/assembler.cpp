@@ -0,0 +1,278 @@
+#include "assembler.hpp"
+#include "arm_assembler.hpp"
+#include "consts.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+
+namespace requests
+{
+    // most instructions sent in one request (the hex for them has to fit a Field)
+    static constexpr size_t BATCH_MAX = 64;
+
+    // splits the hex returned for a batch into one encoding per instruction, empty if it doesn't divide up
+    static std::vector<std::string> split(Arch arch, const char *hex)
+    {
+        std::string digits;
+        for (const char *c = hex; *c != '\0'; c++)
+        {
+            if (isxdigit(static_cast<unsigned char>(*c)))
+                digits += *c;
+        }
+
+        std::vector<std::string> pieces;
+        size_t pos = 0;
+        while (pos < digits.size())
+        {
+            size_t length = 8;
+            if (arch == Arch::Thumb && pos + 4 <= digits.size())
+            {
+                // 32-bit encodings start with a halfword whose top five bits are 0b11101, 0b11110 or 0b11111
+                // (bytes are little endian, so the high byte is the second one)
+                unsigned long high = strtoul(digits.substr(pos + 2, 2).c_str(), nullptr, 16);
+                length = ((high >> 3) >= 0x1D ? 8 : 4);
+            }
+            if (pos + length > digits.size())
+                return {};
+            pieces.push_back(digits.substr(pos, length));
+            pos += length;
+        }
+        return pieces;
+    }
+
+    // true if operands is a single ARM core register
+    static bool isRegister(std::string operands)
+    {
+        operands.erase(std::remove_if(operands.begin(), operands.end(), [](unsigned char c) { return isspace(c); }), operands.end());
+        std::transform(operands.begin(), operands.end(), operands.begin(), [](unsigned char c) { return tolower(c); });
+        static const char *const NAMES[] = {"sp", "lr", "pc", "ip", "fp", "sb", "sl"};
+        for (auto *name : NAMES)
+        {
+            if (operands == name)
+                return true;
+        }
+        if (operands.size() < 2 || operands.size() > 3 || operands[0] != 'r')
+            return false;
+        char *end;
+        long n = strtol(operands.c_str() + 1, &end, 10);
+        return *end == '\0' && isdigit(static_cast<unsigned char>(operands[1])) && n <= 15;
+    }
+
+    // true if the encoding of line depends on where it is placed (branches, ADR/ADRP and literal loads),
+    // those can't share a request with other lines, which the API places 4 bytes apart
+    static bool isPcRelative(const std::string &line)
+    {
+        size_t start = line.find_first_not_of(" \t");
+        if (start == std::string::npos)
+            return false;
+        size_t end = line.find_first_of(" \t", start);
+        std::string mnemonic = line.substr(start, end == std::string::npos ? std::string::npos : end - start);
+        std::transform(mnemonic.begin(), mnemonic.end(), mnemonic.begin(), [](unsigned char c) { return tolower(c); });
+        // the .w/.n width qualifier doesn't change what the instruction is
+        if (mnemonic.size() > 2 && (mnemonic.compare(mnemonic.size() - 2, 2, ".w") == 0 || mnemonic.compare(mnemonic.size() - 2, 2, ".n") == 0))
+            mnemonic.resize(mnemonic.size() - 2);
+        std::string operands = (end == std::string::npos ? "" : line.substr(end));
+
+        static const char *const CONDITIONS[] = {"eq", "ne", "cs", "hs", "cc", "lo", "mi", "pl", "vs", "vc", "hi", "ls", "ge", "lt", "gt", "le", "al"};
+        auto isBranch = [](const std::string &rest) {
+            if (rest.empty())
+                return true;
+            for (auto *cond : CONDITIONS)
+            {
+                if (rest == cond || rest == std::string(".") + cond)
+                    return true;
+            }
+            return false;
+        };
+
+        // B, BL and BLX with a label or immediate (BLX with a register isn't), with or without a condition
+        if (mnemonic[0] == 'b')
+        {
+            std::string rest = mnemonic.substr(1);
+            if (rest.compare(0, 2, "lx") == 0)
+                return !isRegister(operands) && isBranch(rest.substr(2));
+            if (rest.compare(0, 1, "l") == 0 && isBranch(rest.substr(1)))
+                return true;
+            return isBranch(rest);
+        }
+        if (mnemonic == "cbz" || mnemonic == "cbnz" || mnemonic == "tbz" || mnemonic == "tbnz" || mnemonic == "adr" || mnemonic == "adrp")
+            return true;
+        // loads from a label or literal pool rather than an address in registers
+        bool load = mnemonic.compare(0, 3, "ldr") == 0 || mnemonic.compare(0, 4, "vldr") == 0 || mnemonic == "prfm" || mnemonic.compare(0, 3, "pld") == 0;
+        return load && operands.find('[') == std::string::npos;
+    }
+
+    Assembler::Assembler() : m_cache(consts::ASSEMBLY_CACHE_PATH) {}
+
+    void Assembler::assemble(const std::string &line, Arch arch, const std::string &offset, AssembleCallback done)
+    {
+        // the common instructions are encoded here, only the rest need the API
+        Assembled local;
+        auto status = arm::assemble(arch, line, strtoull(offset.c_str(), nullptr, 16), &local.text);
+        if (status != arm::Status::Unsupported)
+        {
+            local.ok = (status == arm::Status::Ok);
+            if (done)
+                done(local);
+            return;
+        }
+
+        Assembled cached;
+        if (m_cache.find(static_cast<int>(arch), offset, line, &cached.ok, &cached.text))
+        {
+            if (done)
+                done(cached);
+            return;
+        }
+
+        auto key = std::to_string(static_cast<int>(arch)) + '\t' + offset + '\t' + line;
+        auto &waiting = m_waiting[key];
+        waiting.push_back(std::move(done));
+        // already queued or in flight
+        if (waiting.size() > 1)
+            return;
+
+        m_queued[static_cast<int>(arch)].push_back(Item{line, offset, key});
+        if (m_wake)
+            m_wake();
+    }
+
+    void Assembler::flush()
+    {
+        for (int i = 0; i < ARCH_COUNT; i++)
+        {
+            if (m_queued[i].empty())
+                continue;
+            auto arch = static_cast<Arch>(i);
+            std::vector<Item> items;
+            items.swap(m_queued[i]);
+
+            // instructions without an offset can go in any order, ones with an offset
+            // only share a request with those directly after them. Without an offset a PC-relative
+            // instruction means one at address 0, so it is always sent on its own
+            std::vector<Item> loose;
+            std::vector<std::pair<uint64_t, Item>> placed;
+            for (auto &item : items)
+            {
+                if (item.offset.empty() && isPcRelative(item.line))
+                    send(arch, {std::move(item)});
+                else if (item.offset.empty())
+                    loose.push_back(std::move(item));
+                else
+                    placed.emplace_back(strtoull(item.offset.c_str(), nullptr, 16), std::move(item));
+            }
+
+            for (size_t start = 0; start < loose.size(); start += BATCH_MAX)
+            {
+                size_t end = std::min(start + BATCH_MAX, loose.size());
+                send(arch, std::vector<Item>(loose.begin() + start, loose.begin() + end));
+            }
+
+            // Thumb instructions are 2 or 4 bytes, so where the next one starts isn't known
+            std::sort(placed.begin(), placed.end(), [](const std::pair<uint64_t, Item> &a, const std::pair<uint64_t, Item> &b) { return a.first < b.first; });
+            std::vector<Item> run;
+            uint64_t next = 0;
+            for (auto &it : placed)
+            {
+                if (!run.empty() && (arch == Arch::Thumb || it.first != next || run.size() == BATCH_MAX))
+                {
+                    send(arch, std::move(run));
+                    run.clear();
+                }
+                run.push_back(std::move(it.second));
+                next = it.first + 4;
+            }
+            if (!run.empty())
+                send(arch, std::move(run));
+        }
+    }
+
+    void Assembler::setWakeFunction(std::function<void()> wake)
+    {
+        m_wake = std::move(wake);
+    }
+
+    void Assembler::send(Arch arch, std::vector<Item> batch)
+    {
+        std::string assembly;
+        for (auto &item : batch)
+        {
+            if (!assembly.empty())
+                assembly += '\n';
+            assembly += item.line;
+        }
+
+        // the batch starts at the first instruction's offset
+        auto offset = batch.front().offset;
+        request(assembly, offset, {arch}, [this, arch, batch = std::move(batch)](const http::Response &res, const ResultParser &parser) {
+            received(arch, batch, res, parser);
+        });
+    }
+
+    void Assembler::received(Arch arch, const std::vector<Item> &batch, const http::Response &res, const ResultParser &parser)
+    {
+        const Result *result = (parser.count() > 0 ? parser.results() : nullptr);
+        const Encoding *enc = nullptr;
+        if (res.ok() && parser.error() == nullptr && result != nullptr && result->error.size == 0)
+            enc = &result->arch[static_cast<int>(arch)];
+
+        if (enc == nullptr || !enc->present)
+        {
+            // the assembler never answered, so nothing is cached and it can be tried again
+            Assembled failed;
+            if (!res.error.empty())
+                failed.text = res.error;
+            else if (!res.ok())
+                failed.text = "HTTP " + std::to_string(res.status);
+            else if (result != nullptr && result->error.size > 0)
+                failed.text = result->error.text;
+            else
+                failed.text = "invalid response";
+            for (auto &item : batch)
+                deliver(item, failed);
+            return;
+        }
+
+        std::vector<std::string> pieces;
+        if (enc->ok && !enc->text.truncated)
+            pieces = split(arch, enc->text.text);
+
+        if (pieces.size() == batch.size())
+        {
+            for (size_t i = 0; i < batch.size(); i++)
+            {
+                m_cache.store(static_cast<int>(arch), batch[i].offset, batch[i].line, true, pieces[i]);
+                deliver(batch[i], Assembled{true, pieces[i]});
+            }
+        }
+        else if (batch.size() > 1)
+        {
+            // one of the lines failed (or the hex didn't divide up), so ask for each on its own
+            for (auto &item : batch)
+                send(arch, {item});
+            return;
+        }
+        else
+        {
+            m_cache.store(static_cast<int>(arch), batch[0].offset, batch[0].line, enc->ok, enc->text.text);
+            deliver(batch[0], Assembled{enc->ok, enc->text.text});
+        }
+        m_cache.save();
+    }
+
+    void Assembler::deliver(const Item &item, const Assembled &result)
+    {
+        auto it = m_waiting.find(item.key);
+        if (it == m_waiting.end())
+            return;
+
+        // callbacks may queue more instructions, which can rehash m_waiting
+        auto callbacks = std::move(it->second);
+        m_waiting.erase(it);
+        for (auto &done : callbacks)
+        {
+            if (done)
+                done(result);
+        }
+    }
+} // namespace requests
@@ -0,0 +1,60 @@
+#pragma once
+#include "assembly_cache.hpp"
+#include "requests.hpp"
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace requests
+{
+    struct Assembled
+    {
+        bool ok = false;
+        std::string text;    // hex when ok, otherwise why it failed
+    };
+
+    using AssembleCallback = std::function<void(const Assembled &)>;
+
+    // Assembles single instructions, locally when arm::assemble() handles them and otherwise through
+    // the API, sending everything queued in a frame as one multi-line request per arch and
+    // remembering answers in an AssemblyCache.
+    class Assembler
+    {
+    private:
+        struct Item
+        {
+            std::string line;
+            std::string offset;
+            std::string key;    // for m_waiting
+        };
+
+        Assembler();
+        Assembler(const Assembler &) = delete;
+
+        void send(Arch arch, std::vector<Item> batch);
+        void received(Arch arch, const std::vector<Item> &batch, const http::Response &res, const ResultParser &parser);
+        void deliver(const Item &item, const Assembled &result);
+
+        AssemblyCache m_cache;
+        std::vector<Item> m_queued[ARCH_COUNT];
+        // callbacks of every queued or in flight instruction, so duplicates share one request
+        std::unordered_map<std::string, std::vector<AssembleCallback>> m_waiting;
+        std::function<void()> m_wake;
+
+    public:
+        static inline auto &getInstance()
+        {
+            static Assembler s_instance;
+            return s_instance;
+        }
+
+        // queue one instruction at offset (hex, may be empty), done runs on the UI thread
+        // (straight away if it was assembled locally or the answer is cached)
+        void assemble(const std::string &line, Arch arch, const std::string &offset, AssembleCallback done);
+        // send what has been queued, call once per frame from the UI thread
+        void flush();
+        // called when something is queued, so the display doesn't sleep before flush()
+        void setWakeFunction(std::function<void()> wake);
+    };
+} // namespace requests
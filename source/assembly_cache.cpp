@@ -0,0 +1,115 @@
+#include "assembly_cache.hpp"
+#include "file_writer.hpp"
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+
+namespace requests
+{
+    // tabs and newlines separate fields and entries in the index, so they can't appear in one
+    static std::string clean(const std::string &s)
+    {
+        std::string out = s;
+        for (auto &c : out)
+        {
+            if (c == '\t' || c == '\n' || c == '\r')
+                c = ' ';
+        }
+        return out;
+    }
+
+    AssemblyCache::AssemblyCache(std::string path) : m_path(std::move(path)) {}
+
+    std::string AssemblyCache::makeKey(int arch, const std::string &offset, const std::string &line)
+    {
+        return std::to_string(arch) + '\t' + clean(offset) + '\t' + clean(line);
+    }
+
+    uint64_t AssemblyCache::hash(const std::string &key)
+    {
+        // FNV-1a
+        uint64_t h = 0xcbf29ce484222325ULL;
+        for (unsigned char c : key)
+        {
+            h ^= c;
+            h *= 0x100000001b3ULL;
+        }
+        return h;
+    }
+
+    void AssemblyCache::load()
+    {
+        m_loaded = true;
+        FILE *fp = fopen(m_path.c_str(), "r");
+        if (fp == nullptr)
+            return;
+
+        // each line is: hash, ok, arch, offset, line, text (tab separated)
+        std::string line;
+        char buf[512];
+        while (fgets(buf, sizeof(buf), fp) != nullptr)
+        {
+            line += buf;
+            if (line.empty() || line.back() != '\n')
+                continue;
+            line.pop_back();
+
+            size_t hashEnd = line.find('\t');
+            size_t okEnd = (hashEnd == std::string::npos ? hashEnd : line.find('\t', hashEnd + 1));
+            size_t textStart = line.rfind('\t');
+            if (okEnd != std::string::npos && textStart > okEnd)
+            {
+                Entry entry;
+                entry.key = line.substr(okEnd + 1, textStart - okEnd - 1);
+                entry.ok = (line.compare(hashEnd + 1, okEnd - hashEnd - 1, "1") == 0);
+                entry.text = line.substr(textStart + 1);
+                // later lines replace earlier ones for the same key
+                m_entries[hash(entry.key)] = std::move(entry);
+            }
+            line.clear();
+        }
+        fclose(fp);
+    }
+
+    bool AssemblyCache::find(int arch, const std::string &offset, const std::string &line, bool *ok, std::string *text)
+    {
+        if (!m_loaded)
+            load();
+
+        auto key = makeKey(arch, offset, line);
+        auto it = m_entries.find(hash(key));
+        if (it == m_entries.end() || it->second.key != key)
+            return false;
+
+        *ok = it->second.ok;
+        *text = it->second.text;
+        return true;
+    }
+
+    void AssemblyCache::store(int arch, const std::string &offset, const std::string &line, bool ok, const std::string &text)
+    {
+        if (!m_loaded)
+            load();
+
+        Entry entry;
+        entry.key = makeKey(arch, offset, line);
+        entry.ok = ok;
+        entry.text = clean(text);
+        uint64_t h = hash(entry.key);
+
+        char prefix[24];
+        snprintf(prefix, sizeof(prefix), "%016" PRIx64 "\t%d\t", h, ok ? 1 : 0);
+        m_unsaved += prefix + entry.key + '\t' + entry.text + '\n';
+        m_entries[h] = std::move(entry);
+    }
+
+    void AssemblyCache::save()
+    {
+        if (m_unsaved.empty())
+            return;
+
+        // written on the FileWriter thread, this is called from the UI thread
+        io::FileWriter::getInstance().writeFile(m_path, m_unsaved, io::Mode::Append);
+        m_unsaved.clear();
+    }
+} // namespace requests
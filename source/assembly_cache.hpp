@@ -0,0 +1,41 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+namespace requests
+{
+    // Remembers what the assembler returned for each (arch, offset, line) so repeated patches
+    // never reach the network. Entries are addressed by a hash of the key and appended to a
+    // plain text index file, which is read back the first time the cache is used.
+    class AssemblyCache
+    {
+    private:
+        struct Entry
+        {
+            std::string key;    // checked on lookup, in case two keys share a hash
+            bool ok;
+            std::string text;
+        };
+
+        static std::string makeKey(int arch, const std::string &offset, const std::string &line);
+        static uint64_t hash(const std::string &key);
+        void load();
+
+        std::string m_path;
+        bool m_loaded = false;
+        std::unordered_map<uint64_t, Entry> m_entries;
+        // lines not yet written to the index
+        std::string m_unsaved;
+
+    public:
+        explicit AssemblyCache(std::string path);
+
+        // returns false on a miss
+        bool find(int arch, const std::string &offset, const std::string &line, bool *ok, std::string *text);
+        // only store answers from the assembler, never transport errors
+        void store(int arch, const std::string &offset, const std::string &line, bool ok, const std::string &text);
+        // append stored entries to the index in one write (queued, it doesn't wait for the card)
+        void save();
+    };
+} // namespace requests
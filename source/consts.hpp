@@ -11,4 +11,16 @@ namespace consts
     auto constexpr COLOR_SUCCESS = Aether::Colour{92, 184, 92, 0xFF};
     auto constexpr COLOR_FAIL = Aether::Colour{217, 83, 79, 0xFF};
 
+    // answers from the assembler, so repeated patches don't need the network (a new name whenever
+    // entries written by earlier versions can't be trusted)
+    auto constexpr ASSEMBLY_CACHE_PATH = "assembly_cache_v2.tsv";
+
+    auto constexpr API_URL = "https://armconverter.com/api/convert";
+    // when present its first line replaces API_URL (e.g. a local stand-in server to measure against, see
+    // tools/), followed by " insecure" if the server's certificate is self-signed. That is only honoured
+    // for loopback and private network addresses
+    auto constexpr API_URL_PATH = "api_url.txt";
+    // per-request timings, written on exit
+    auto constexpr REQUEST_LOG_PATH = "request_timings.log";
+
 } // namespace consts
@@ -0,0 +1,200 @@
+#include "file_writer.hpp"
+#include <unistd.h>
+#include <vector>
+
+namespace io
+{
+    FileWriter::FileWriter() = default;
+
+    FileWriter &FileWriter::getInstance()
+    {
+        static FileWriter s_instance;
+        return s_instance;
+    }
+
+    FileWriter::~FileWriter()
+    {
+        if (!m_thread.joinable())
+            return;
+
+        // the writer thread drains the queue before it stops
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_work.notify_one();
+        m_thread.join();
+    }
+
+    void FileWriter::start()
+    {
+        // the thread is only started once there is something to write
+        static std::once_flag flag;
+        std::call_once(flag, [this]() { m_thread = std::thread(&FileWriter::run, this); });
+    }
+
+    void FileWriter::run()
+    {
+        struct Job
+        {
+            FileId id;
+            File *file;
+            std::string data;
+            bool close;
+            bool ok;
+        };
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true)
+        {
+            auto urgent = [this]() { return m_stop || m_closing > 0 || m_flushRequested != m_flushDone || m_queued >= WRITE_MIN; };
+            if (m_queued == 0 && !urgent())
+            {
+                m_work.wait(lock, [this, &urgent]() { return m_queued > 0 || urgent(); });
+                continue;
+            }
+            if (m_queued == 0 && m_closing == 0 && m_flushRequested == m_flushDone)
+                break;
+            // let small writes gather, the wait ends early if a caller needs them out
+            if (!urgent())
+                m_work.wait_for(lock, std::chrono::milliseconds(LINGER_MS), urgent);
+
+            uint64_t flush = m_flushRequested;
+            bool sync = m_syncRequested;
+            m_syncRequested = false;
+
+            std::vector<Job> jobs;
+            for (auto &it : m_files)
+            {
+                auto *file = it.second.get();
+                // a sync covers what earlier rounds wrote to open files too
+                if (file->pending.empty() && !file->closing && !(sync && file->fp != nullptr))
+                    continue;
+                jobs.push_back(Job{it.first, file, std::move(file->pending), file->closing, true});
+                file->pending.clear();
+            }
+
+            // a file is only erased by this thread, so the pointers stay valid while unlocked
+            lock.unlock();
+            for (auto &job : jobs)
+                job.ok = writeOut(job.file, job.data, job.close, sync);
+            lock.lock();
+
+            std::vector<std::pair<DoneCallback, bool>> done;
+            for (auto &job : jobs)
+            {
+                m_queued -= job.data.size();
+                job.file->failed = job.file->failed || !job.ok;
+                if (!job.close)
+                    continue;
+                if (job.file->done)
+                    done.emplace_back(std::move(job.file->done), !job.file->failed);
+                m_closing--;
+                m_files.erase(job.id);
+            }
+
+            // callbacks run before waiting flush() calls return
+            if (!done.empty())
+            {
+                lock.unlock();
+                for (auto &callback : done)
+                    callback.first(callback.second);
+                lock.lock();
+            }
+            m_flushDone = flush;
+            m_written.notify_all();
+        }
+    }
+
+    bool FileWriter::writeOut(File *file, const std::string &data, bool close, bool sync)
+    {
+        bool ok = !file->failed;
+        if (ok && file->fp == nullptr && (!data.empty() || close))
+        {
+            file->fp = fopen(file->path.c_str(), file->mode == Mode::Append ? "ab" : "wb");
+            // writes are already coalesced, another copy into a stdio buffer would only cost time
+            if (file->fp != nullptr)
+                setvbuf(file->fp, nullptr, _IONBF, 0);
+            ok = (file->fp != nullptr);
+        }
+
+        if (ok && !data.empty())
+            ok = (fwrite(data.data(), 1, data.size(), file->fp) == data.size());
+        if (ok && sync)
+            ok = (fsync(fileno(file->fp)) == 0);
+
+        if (close && file->fp != nullptr)
+        {
+            ok = (fclose(file->fp) == 0) && ok;
+            file->fp = nullptr;
+        }
+        return ok;
+    }
+
+    FileId FileWriter::open(std::string path, Mode mode)
+    {
+        start();
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto file = std::make_unique<File>();
+        file->path = std::move(path);
+        file->mode = mode;
+        auto id = m_nextId++;
+        m_files[id] = std::move(file);
+        return id;
+    }
+
+    bool FileWriter::write(FileId id, const char *data, size_t size)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        // a write bigger than the whole queue still goes through once the queue is empty
+        m_written.wait(lock, [this, size]() { return m_queued == 0 || m_queued + size <= QUEUE_MAX; });
+
+        auto it = m_files.find(id);
+        if (it == m_files.end() || it->second->closing || it->second->failed)
+            return false;
+
+        bool wasBelow = (m_queued < WRITE_MIN);
+        it->second->pending.append(data, size);
+        m_queued += size;
+        lock.unlock();
+
+        // the writer thread only needs waking to start waiting or once there is a full write
+        if (wasBelow)
+            m_work.notify_one();
+        return true;
+    }
+
+    void FileWriter::close(FileId id, DoneCallback done)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_files.find(id);
+            if (it == m_files.end() || it->second->closing)
+                return;
+            it->second->closing = true;
+            it->second->done = std::move(done);
+            m_closing++;
+        }
+        m_work.notify_one();
+    }
+
+    void FileWriter::writeFile(std::string path, const std::string &data, Mode mode, DoneCallback done)
+    {
+        auto id = open(std::move(path), mode);
+        write(id, data.data(), data.size());
+        close(id, std::move(done));
+    }
+
+    void FileWriter::flush(bool sync)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (!m_thread.joinable())
+            return;
+
+        uint64_t target = ++m_flushRequested;
+        m_syncRequested = m_syncRequested || sync;
+        m_work.notify_one();
+        m_written.wait(lock, [this, target]() { return m_flushDone >= target; });
+    }
+} // namespace io
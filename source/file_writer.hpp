@@ -0,0 +1,86 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace io
+{
+    using FileId = uint64_t;
+
+    enum class Mode
+    {
+        Truncate,
+        Append,
+    };
+
+    // called on the writer thread once a file is closed, ok is false if anything failed to write
+    using DoneCallback = std::function<void(bool ok)>;
+
+    // Writes files on its own thread so the UI and network threads never wait for the SD card.
+    // Data is copied into a buffer per file and written out in large pieces, small writes are held
+    // for a moment so they go out together. Callers only block when more than QUEUE_MAX bytes are
+    // waiting (back-pressure) or when they ask to with flush().
+    class FileWriter
+    {
+    private:
+        struct File
+        {
+            std::string path;
+            Mode mode;
+            std::string pending;    // queued but not yet taken by the writer thread
+            bool closing = false;
+            bool failed = false;
+            DoneCallback done;
+            FILE *fp = nullptr;     // only used on the writer thread
+        };
+
+        FileWriter();
+        FileWriter(const FileWriter &) = delete;
+        ~FileWriter();
+
+        void start();
+        void run();
+        bool writeOut(File *file, const std::string &data, bool close, bool sync);
+
+        std::thread m_thread;
+
+        // guards everything below (shared with the writer thread)
+        std::mutex m_mutex;
+        std::condition_variable m_work;     // something was queued
+        std::condition_variable m_written;  // the writer thread finished a round
+        bool m_stop = false;
+        FileId m_nextId = 1;
+        // ids only increase, so files are written in the order they were opened
+        std::map<FileId, std::unique_ptr<File>> m_files;
+        size_t m_queued = 0;                // pending bytes over every file
+        size_t m_closing = 0;
+        uint64_t m_flushRequested = 0;
+        uint64_t m_flushDone = 0;
+        bool m_syncRequested = false;
+
+    public:
+        static constexpr size_t QUEUE_MAX = 1024 * 1024;
+        // writes below this wait up to LINGER_MS for more data
+        static constexpr size_t WRITE_MIN = 64 * 1024;
+        static constexpr long LINGER_MS = 200;
+
+        static FileWriter &getInstance();
+
+        // the file is only opened on the writer thread, failures show up in write() and close()
+        FileId open(std::string path, Mode mode);
+        // copies data to the queue, waiting while it is full. false once the file has failed
+        bool write(FileId file, const char *data, size_t size);
+        // closes once everything queued for the file is written
+        void close(FileId file, DoneCallback done = nullptr);
+        // open, write and close in one go
+        void writeFile(std::string path, const std::string &data, Mode mode, DoneCallback done = nullptr);
+        // blocks until everything queued before the call is written, with sync until it is on the card
+        void flush(bool sync);
+    };
+} // namespace io
@@ -0,0 +1,408 @@
+#include "http.hpp"
+#include "Aether/utils/Trace.hpp"
+#include "file_writer.hpp"
+
+namespace http
+{
+    struct Client::Transfer
+    {
+        RequestId id;
+        Request request;
+        Callback done;
+        CURL *easy = nullptr;
+        curl_slist *headers = nullptr;
+        bool cancelled = false;
+        Response response;
+    };
+
+    DataCallback saveTo(std::string path)
+    {
+        // the FileWriter thread does the writing, so a slow SD card never holds up the transfers
+        struct Output
+        {
+            std::string path;
+            io::FileId file = 0;
+
+            ~Output()
+            {
+                if (file != 0)
+                    io::FileWriter::getInstance().close(file);
+            }
+        };
+
+        // shared so the file is closed once the request holding the callback goes away
+        auto output = std::make_shared<Output>();
+        output->path = std::move(path);
+        return [output](const char *data, size_t size) {
+            auto &writer = io::FileWriter::getInstance();
+            if (output->file == 0)
+                output->file = writer.open(output->path, io::Mode::Truncate);
+            return writer.write(output->file, data, size);
+        };
+    }
+
+    size_t Client::writeBody(char *ptr, size_t size, size_t nmemb, void *userdata)
+    {
+        auto *t = static_cast<Transfer *>(userdata);
+        size_t total = size * nmemb;
+        t->response.bytesReceived += total;
+
+        // hand the chunk straight to the consumer without buffering it
+        if (t->request.onData)
+            return t->request.onData(ptr, total) ? total : 0;
+
+        // grow the body once if the size is known up front (only a lower bound for a compressed body)
+        if (t->response.body.empty())
+        {
+            curl_off_t length = -1;
+            curl_easy_getinfo(t->easy, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &length);
+            if (length > 0)
+                t->response.body.reserve(length);
+        }
+        t->response.body.append(ptr, total);
+        t->response.bytesCopied += total;
+        return total;
+    }
+
+    Client::Client()
+    {
+        // constructed first so it is destroyed after the transfers which may still be writing to it
+        io::FileWriter::getInstance();
+    }
+
+    Client &Client::getInstance()
+    {
+        static Client s_instance;
+        return s_instance;
+    }
+
+    Client::~Client()
+    {
+        if (!m_thread.joinable())
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        curl_multi_wakeup(m_multi);
+        m_thread.join();
+
+        for (auto &it : m_active)
+        {
+            curl_multi_remove_handle(m_multi, it.second->easy);
+            curl_easy_cleanup(it.second->easy);
+            curl_slist_free_all(it.second->headers);
+        }
+        m_active.clear();
+        for (auto *easy : m_idle)
+            curl_easy_cleanup(easy);
+        m_idle.clear();
+        curl_multi_cleanup(m_multi);
+        curl_share_cleanup(m_share);
+        curl_global_cleanup();
+    }
+
+    void Client::start()
+    {
+        // curl and the I/O thread are set up by the first request instead of at startup
+        static std::once_flag flag;
+        std::call_once(flag, [this]() {
+            curl_global_init(CURL_GLOBAL_DEFAULT);
+            m_multi = curl_multi_init();
+            // several requests to one host share a single HTTP/2 connection where the server allows it
+            curl_multi_setopt(m_multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+            curl_multi_setopt(m_multi, CURLMOPT_MAXCONNECTS, 8L);
+
+            // connections are already pooled by the multi handle, the share keeps DNS and TLS sessions
+            // (every handle lives on the I/O thread, so it needs no lock functions)
+            m_share = curl_share_init();
+            curl_share_setopt(m_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+            curl_share_setopt(m_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+            m_thread = std::thread(&Client::run, this);
+            Aether::Trace::mark("curl initialized");
+        });
+    }
+
+    void Client::run()
+    {
+        while (true)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_stop)
+                    break;
+
+                // abort cancelled transfers, then fill the free slots
+                for (auto id : m_cancelled)
+                {
+                    auto it = m_active.find(id);
+                    if (it == m_active.end())
+                        continue;
+                    curl_multi_remove_handle(m_multi, it->second->easy);
+                    releaseHandle(it->second->easy);
+                    curl_slist_free_all(it->second->headers);
+                    m_active.erase(it);
+                }
+                m_cancelled.clear();
+                startQueued();
+            }
+
+            int running = 0;
+            curl_multi_perform(m_multi, &running);
+
+            CURLMsg *msg;
+            int left = 0;
+            while ((msg = curl_multi_info_read(m_multi, &left)) != nullptr)
+            {
+                if (msg->msg != CURLMSG_DONE)
+                    continue;
+
+                Transfer *transfer = nullptr;
+                curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, &transfer);
+                finish(transfer, msg->data.result);
+            }
+
+            // sleeps until there is socket activity, a timeout or curl_multi_wakeup()
+            curl_multi_poll(m_multi, nullptr, 0, 1000, nullptr);
+        }
+    }
+
+    void Client::startQueued()
+    {
+        while (m_active.size() < m_maxConcurrent && !m_queued.empty())
+        {
+            auto transfer = std::move(m_queued.front());
+            m_queued.pop_front();
+
+            auto *t = transfer.get();
+            t->easy = acquireHandle();
+            if (t->easy == nullptr)
+            {
+                t->response.result = CURLE_FAILED_INIT;
+                t->response.error = curl_easy_strerror(CURLE_FAILED_INIT);
+                m_completed.push_back(std::move(transfer));
+                continue;
+            }
+
+            curl_easy_setopt(t->easy, CURLOPT_URL, t->request.url.c_str());
+            if (t->request.method != "GET")
+                curl_easy_setopt(t->easy, CURLOPT_CUSTOMREQUEST, t->request.method.c_str());
+            if (!t->request.body.empty())
+            {
+                curl_easy_setopt(t->easy, CURLOPT_POSTFIELDS, t->request.body.c_str());
+                curl_easy_setopt(t->easy, CURLOPT_POSTFIELDSIZE, static_cast<long>(t->request.body.size()));
+            }
+            for (auto &header : t->request.headers)
+                t->headers = curl_slist_append(t->headers, header.c_str());
+            if (t->headers != nullptr)
+                curl_easy_setopt(t->easy, CURLOPT_HTTPHEADER, t->headers);
+
+            curl_easy_setopt(t->easy, CURLOPT_FOLLOWLOCATION, 1L);
+            curl_easy_setopt(t->easy, CURLOPT_DEFAULT_PROTOCOL, "https");
+            curl_easy_setopt(t->easy, CURLOPT_TIMEOUT_MS, t->request.timeoutMs);
+            curl_easy_setopt(t->easy, CURLOPT_CONNECTTIMEOUT_MS, t->request.connectTimeoutMs);
+            curl_easy_setopt(t->easy, CURLOPT_NOSIGNAL, 1L);
+            curl_easy_setopt(t->easy, CURLOPT_SHARE, m_share);
+            curl_easy_setopt(t->easy, CURLOPT_TCP_KEEPALIVE, 1L);
+            curl_easy_setopt(t->easy, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+            curl_easy_setopt(t->easy, CURLOPT_PIPEWAIT, 1L);
+            // "" offers every encoding curl was built with
+            if (t->request.compressed)
+                curl_easy_setopt(t->easy, CURLOPT_ACCEPT_ENCODING, "");
+            if (!t->request.verifyPeer)
+            {
+                curl_easy_setopt(t->easy, CURLOPT_SSL_VERIFYPEER, 0L);
+                curl_easy_setopt(t->easy, CURLOPT_SSL_VERIFYHOST, 0L);
+            }
+            curl_easy_setopt(t->easy, CURLOPT_WRITEFUNCTION, writeBody);
+            curl_easy_setopt(t->easy, CURLOPT_WRITEDATA, t);
+            curl_easy_setopt(t->easy, CURLOPT_PRIVATE, t);
+
+            curl_multi_add_handle(m_multi, t->easy);
+            m_active[t->id] = std::move(transfer);
+        }
+    }
+
+    void Client::finish(Transfer *transfer, CURLcode result)
+    {
+        auto &res = transfer->response;
+        curl_off_t connect = 0, tls = 0, firstByte = 0, total = 0, wire = 0;
+        curl_easy_getinfo(transfer->easy, CURLINFO_RESPONSE_CODE, &res.status);
+        curl_easy_getinfo(transfer->easy, CURLINFO_NUM_CONNECTS, &res.connects);
+        curl_easy_getinfo(transfer->easy, CURLINFO_CONNECT_TIME_T, &connect);
+        curl_easy_getinfo(transfer->easy, CURLINFO_APPCONNECT_TIME_T, &tls);
+        curl_easy_getinfo(transfer->easy, CURLINFO_STARTTRANSFER_TIME_T, &firstByte);
+        curl_easy_getinfo(transfer->easy, CURLINFO_TOTAL_TIME_T, &total);
+        // counted before content decoding
+        curl_easy_getinfo(transfer->easy, CURLINFO_SIZE_DOWNLOAD_T, &wire);
+        res.connectUs = connect;
+        res.tlsUs = tls;
+        res.firstByteUs = firstByte;
+        res.totalUs = total;
+        res.wireBytes = wire;
+        transfer->response.result = result;
+        if (result != CURLE_OK)
+            transfer->response.error = curl_easy_strerror(result);
+
+        curl_multi_remove_handle(m_multi, transfer->easy);
+        curl_slist_free_all(transfer->headers);
+        transfer->headers = nullptr;
+
+        std::function<void()> wake;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            releaseHandle(transfer->easy);
+            transfer->easy = nullptr;
+
+            m_stats.requests++;
+            if (!res.ok())
+                m_stats.failed++;
+            m_stats.wireBytes += res.wireBytes;
+            m_stats.bytesReceived += res.bytesReceived;
+            m_stats.bytesCopied += res.bytesCopied;
+            m_stats.firstByteUs += res.firstByteUs;
+            m_stats.totalUs += res.totalUs;
+            m_stats.elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_statsStart).count();
+
+            auto it = m_active.find(transfer->id);
+            if (!transfer->cancelled)
+                m_completed.push_back(std::move(it->second));
+            m_active.erase(it);
+            wake = m_wake;
+        }
+
+        if (wake)
+            wake();
+    }
+
+    CURL *Client::acquireHandle()
+    {
+        if (m_idle.empty())
+            return curl_easy_init();
+
+        // reset clears options but keeps the handle's caches
+        auto *easy = m_idle.back();
+        m_idle.pop_back();
+        curl_easy_reset(easy);
+        return easy;
+    }
+
+    void Client::releaseHandle(CURL *easy)
+    {
+        // keeps as many as can run at once
+        if (m_idle.size() < m_maxConcurrent)
+            m_idle.push_back(easy);
+        else
+            curl_easy_cleanup(easy);
+    }
+
+    RequestId Client::send(Request request, Callback done)
+    {
+        start();
+
+        RequestId id;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            id = m_nextId++;
+            auto transfer = std::make_unique<Transfer>();
+            transfer->id = id;
+            transfer->request = std::move(request);
+            transfer->done = std::move(done);
+            m_queued.push_back(std::move(transfer));
+            if (!m_statsStarted)
+            {
+                m_statsStart = std::chrono::steady_clock::now();
+                m_statsStarted = true;
+            }
+        }
+        curl_multi_wakeup(m_multi);
+        return id;
+    }
+
+    bool Client::cancel(RequestId id)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto it = m_queued.begin(); it != m_queued.end(); it++)
+        {
+            if ((*it)->id == id)
+            {
+                m_queued.erase(it);
+                return true;
+            }
+        }
+
+        auto active = m_active.find(id);
+        if (active != m_active.end())
+        {
+            // aborted by the I/O thread, in case it finishes first it is also flagged
+            active->second->cancelled = true;
+            m_cancelled.push_back(id);
+            curl_multi_wakeup(m_multi);
+            return true;
+        }
+
+        for (auto it = m_completed.begin(); it != m_completed.end(); it++)
+        {
+            if ((*it)->id == id)
+            {
+                m_completed.erase(it);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void Client::poll()
+    {
+        std::vector<std::unique_ptr<Transfer>> completed;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_completed.empty())
+                return;
+            completed.swap(m_completed);
+        }
+
+        // callbacks may send more requests, so the lock isn't held
+        for (auto &transfer : completed)
+        {
+            if (transfer->done)
+                transfer->done(transfer->response);
+        }
+    }
+
+    bool Client::busy()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return !m_queued.empty() || !m_active.empty() || !m_completed.empty();
+    }
+
+    void Client::setMaxConcurrent(size_t max)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_maxConcurrent = (max == 0 ? 1 : max);
+        }
+        if (m_multi != nullptr)
+            curl_multi_wakeup(m_multi);
+    }
+
+    Stats Client::stats()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_stats;
+    }
+
+    void Client::resetStats()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats = Stats();
+        m_statsStarted = false;
+    }
+
+    void Client::setWakeFunction(std::function<void()> wake)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_wake = std::move(wake);
+    }
+} // namespace http
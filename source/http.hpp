@@ -0,0 +1,139 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <curl/curl.h>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace http
+{
+    using RequestId = uint64_t;
+
+    // receives the body a chunk at a time straight from curl's buffer, return false to abort the transfer
+    using DataCallback = std::function<bool(const char *data, size_t size)>;
+
+    struct Request
+    {
+        std::string url;
+        std::string method = "GET";
+        std::string body;
+        std::vector<std::string> headers;
+        long timeoutMs = 15000;        // whole transfer, including connecting
+        long connectTimeoutMs = 5000;
+        // only turned off for a local stand-in server with a self-signed certificate
+        bool verifyPeer = true;
+        // offer gzip/deflate, curl inflates the body as it arrives so onData still sees it chunk by chunk
+        bool compressed = true;
+        // called on the I/O thread as the body arrives, when set the body isn't kept in Response::body
+        DataCallback onData;
+    };
+
+    struct Response
+    {
+        long status = 0;     // HTTP status code (0 if no response)
+        int result = 0;      // CURLcode of the transfer
+        std::string error;   // description of result when it isn't CURLE_OK
+        std::string body;    // empty if Request::onData was set
+
+        // connections opened (0 when an existing one was reused) and timings in microseconds
+        // from the start of the transfer, to compare cold and warm requests
+        long connects = 0;
+        long long connectUs = 0;
+        long long tlsUs = 0;
+        long long firstByteUs = 0;
+        long long totalUs = 0;
+
+        // body bytes as sent by the server (compressed) and as decoded, and how many of the
+        // decoded ones were copied into body
+        size_t wireBytes = 0;
+        size_t bytesReceived = 0;
+        size_t bytesCopied = 0;
+
+        bool ok() const { return result == 0 && status >= 200 && status < 300; }
+    };
+
+    using Callback = std::function<void(const Response &)>;
+
+    // totals over every finished request since the first one (or resetStats())
+    struct Stats
+    {
+        size_t requests = 0;
+        size_t failed = 0;
+        size_t wireBytes = 0;
+        size_t bytesReceived = 0;
+        size_t bytesCopied = 0;
+        long long firstByteUs = 0;  // summed, divide by requests for the average
+        long long totalUs = 0;      // summed
+        long long elapsedUs = 0;    // wall time from the first request starting to the last finishing
+
+        double requestsPerSecond() const { return elapsedUs > 0 ? requests * 1e6 / elapsedUs : 0; }
+    };
+
+    // returns a DataCallback writing the body to a file, which is only created once data arrives
+    DataCallback saveTo(std::string path);
+
+    // Runs transfers on a curl multi handle in its own thread so the UI never blocks on the network.
+    // Callbacks are queued and only run from poll(), which the application calls once per frame.
+    class Client
+    {
+    private:
+        struct Transfer;
+
+        Client();
+        Client(const Client &) = delete;
+        ~Client();
+
+        static size_t writeBody(char *ptr, size_t size, size_t nmemb, void *userdata);
+
+        void start();
+        void run();
+        void startQueued();
+        void finish(Transfer *transfer, CURLcode result);
+        CURL *acquireHandle();
+        void releaseHandle(CURL *easy);
+
+        CURLM *m_multi = nullptr;
+        // DNS cache, TLS sessions and connections shared by every handle (only used on the I/O thread)
+        CURLSH *m_share = nullptr;
+        // finished easy handles kept for reuse (only used on the I/O thread)
+        std::vector<CURL *> m_idle;
+        std::thread m_thread;
+        bool m_stop = false;
+        size_t m_maxConcurrent = 4;
+        RequestId m_nextId = 1;
+        std::function<void()> m_wake;
+
+        // guards everything below (shared with the I/O thread)
+        std::mutex m_mutex;
+        std::deque<std::unique_ptr<Transfer>> m_queued;
+        std::unordered_map<RequestId, std::unique_ptr<Transfer>> m_active;
+        std::vector<RequestId> m_cancelled;
+        std::vector<std::unique_ptr<Transfer>> m_completed;
+        Stats m_stats;
+        std::chrono::steady_clock::time_point m_statsStart;
+        bool m_statsStarted = false;
+
+    public:
+        static Client &getInstance();
+
+        // queue a request, done is called on the thread calling poll() (never if cancelled)
+        RequestId send(Request request, Callback done);
+        // returns false if the request has already completed
+        bool cancel(RequestId id);
+        // run callbacks of completed requests, call once per frame from the UI thread
+        void poll();
+        // true while any request is queued, running or waiting for poll()
+        bool busy();
+        void setMaxConcurrent(size_t max);
+        Stats stats();
+        void resetStats();
+        // called from the I/O thread when a request completes (e.g. to wake an idle display)
+        void setWakeFunction(std::function<void()> wake);
+    };
+} // namespace http
@@ -0,0 +1,468 @@
+#include "json.hpp"
+#include <cstdlib>
+
+namespace json
+{
+    // UTF-8 for U+FFFD, used for unpaired surrogates
+    static const char REPLACEMENT[] = "\xEF\xBF\xBD";
+
+    static bool isSpace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
+
+    static bool isDigit(char c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    static int hexValue(char c)
+    {
+        if (isDigit(c))
+            return c - '0';
+        if (c >= 'a' && c <= 'f')
+            return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F')
+            return c - 'A' + 10;
+        return -1;
+    }
+
+    // -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?, strtod alone would accept hex, inf, etc.
+    static bool validNumber(const char *s)
+    {
+        if (*s == '-')
+            s++;
+        if (*s == '0')
+            s++;
+        else if (isDigit(*s))
+            while (isDigit(*s))
+                s++;
+        else
+            return false;
+
+        if (*s == '.')
+        {
+            s++;
+            if (!isDigit(*s))
+                return false;
+            while (isDigit(*s))
+                s++;
+        }
+
+        if (*s == 'e' || *s == 'E')
+        {
+            s++;
+            if (*s == '+' || *s == '-')
+                s++;
+            if (!isDigit(*s))
+                return false;
+            while (isDigit(*s))
+                s++;
+        }
+        return *s == '\0';
+    }
+
+    Parser::Parser(Handler &handler) : m_handler(handler) {}
+
+    bool Parser::feed(const char *data, size_t size)
+    {
+        if (m_error != nullptr)
+            return false;
+
+        // unescaped characters of a string are passed on in one piece straight from data
+        const char *run = (m_state == State::String ? data : nullptr);
+
+        size_t i = 0;
+        while (i < size)
+        {
+            char c = data[i];
+            bool consumed = true;
+
+            switch (m_state)
+            {
+            case State::FirstValue:
+                if (c == ']')
+                {
+                    m_depth--;
+                    m_handler.endArray();
+                    endValue();
+                    break;
+                }
+                if (!isSpace(c))
+                {
+                    m_state = State::Value;
+                    consumed = false;
+                }
+                break;
+
+            case State::Value:
+                if (isSpace(c))
+                    break;
+                if (c == '{')
+                {
+                    if (!push(c))
+                        return false;
+                    m_handler.beginObject();
+                    m_state = State::FirstKey;
+                }
+                else if (c == '[')
+                {
+                    if (!push(c))
+                        return false;
+                    m_handler.beginArray();
+                    m_state = State::FirstValue;
+                }
+                else if (c == '"')
+                {
+                    m_isKey = false;
+                    m_state = State::String;
+                    run = data + i + 1;
+                }
+                else if (c == 't' || c == 'f' || c == 'n')
+                {
+                    m_literal = (c == 't' ? "true" : (c == 'f' ? "false" : "null"));
+                    m_literalPos = 1;
+                    m_state = State::Literal;
+                }
+                else if (c == '-' || isDigit(c))
+                {
+                    m_token[0] = c;
+                    m_tokenSize = 1;
+                    m_state = State::Number;
+                }
+                else
+                    return fail("unexpected character");
+                break;
+
+            case State::FirstKey:
+            case State::Key:
+                if (isSpace(c))
+                    break;
+                if (c == '}' && m_state == State::FirstKey)
+                {
+                    m_depth--;
+                    m_handler.endObject();
+                    endValue();
+                }
+                else if (c == '"')
+                {
+                    m_isKey = true;
+                    m_tokenSize = 0;
+                    m_state = State::String;
+                    run = data + i + 1;
+                }
+                else
+                    return fail("expected a key");
+                break;
+
+            case State::Colon:
+                if (isSpace(c))
+                    break;
+                if (c != ':')
+                    return fail("expected ':'");
+                m_state = State::Value;
+                break;
+
+            case State::AfterValue:
+                if (isSpace(c))
+                    break;
+                if (c == ',')
+                    m_state = (m_stack[m_depth - 1] == '{' ? State::Key : State::Value);
+                else if (c == '}' || c == ']')
+                {
+                    if ((c == '}') != (m_stack[m_depth - 1] == '{'))
+                        return fail("mismatched bracket");
+                    m_depth--;
+                    if (c == '}')
+                        m_handler.endObject();
+                    else
+                        m_handler.endArray();
+                    endValue();
+                }
+                else
+                    return fail("expected ',' or the end of the container");
+                break;
+
+            case State::String:
+                if (c == '"')
+                {
+                    dropSurrogate();
+                    if (m_isKey)
+                    {
+                        stringPiece(run, data + i - run);
+                        m_handler.key(m_token, m_tokenSize);
+                        m_state = State::Colon;
+                    }
+                    else
+                    {
+                        m_handler.string(run, data + i - run, true);
+                        endValue();
+                    }
+                    run = nullptr;
+                }
+                else if (c == '\\')
+                {
+                    stringPiece(run, data + i - run);
+                    run = nullptr;
+                    m_state = State::Escape;
+                }
+                else if (static_cast<unsigned char>(c) < 0x20)
+                    return fail("control character in string");
+                else if (m_highSurrogate != 0)
+                {
+                    // the run starts here, so the replacement still comes first
+                    dropSurrogate();
+                }
+                break;
+
+            case State::Escape:
+            {
+                char decoded;
+                switch (c)
+                {
+                case '"':
+                case '\\':
+                case '/':
+                    decoded = c;
+                    break;
+                case 'b':
+                    decoded = '\b';
+                    break;
+                case 'f':
+                    decoded = '\f';
+                    break;
+                case 'n':
+                    decoded = '\n';
+                    break;
+                case 'r':
+                    decoded = '\r';
+                    break;
+                case 't':
+                    decoded = '\t';
+                    break;
+                case 'u':
+                    m_unicode = 0;
+                    m_unicodeDigits = 0;
+                    m_state = State::Unicode;
+                    break;
+                default:
+                    return fail("invalid escape");
+                }
+
+                if (m_state == State::Escape)
+                {
+                    dropSurrogate();
+                    stringPiece(&decoded, 1);
+                    m_state = State::String;
+                    run = data + i + 1;
+                }
+                break;
+            }
+
+            case State::Unicode:
+            {
+                int value = hexValue(c);
+                if (value < 0)
+                    return fail("invalid unicode escape");
+                m_unicode = (m_unicode << 4) | value;
+                if (++m_unicodeDigits == 4)
+                {
+                    codePoint(m_unicode);
+                    m_state = State::String;
+                    run = data + i + 1;
+                }
+                break;
+            }
+
+            case State::Literal:
+                if (c != m_literal[m_literalPos])
+                    return fail("invalid literal");
+                if (m_literal[++m_literalPos] == '\0')
+                {
+                    if (m_literal[0] == 'n')
+                        m_handler.null();
+                    else
+                        m_handler.boolean(m_literal[0] == 't');
+                    endValue();
+                }
+                break;
+
+            case State::Number:
+                if (isDigit(c) || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E')
+                {
+                    if (m_tokenSize == TOKEN_MAX - 1)
+                        return fail("number too long");
+                    m_token[m_tokenSize++] = c;
+                }
+                else
+                {
+                    // the character after the number still needs parsing
+                    if (!endNumber())
+                        return false;
+                    consumed = false;
+                }
+                break;
+
+            case State::Done:
+                if (!isSpace(c))
+                    return fail("unexpected data after the document");
+                break;
+            }
+
+            if (consumed)
+            {
+                i++;
+                m_offset++;
+            }
+        }
+
+        // the rest of the string arrives with the next chunk
+        if (m_state == State::String && run != nullptr)
+            stringPiece(run, data + size - run);
+        return true;
+    }
+
+    bool Parser::end()
+    {
+        if (m_error != nullptr)
+            return false;
+        // a number at the top level only ends with the document
+        if (m_state == State::Number && !endNumber())
+            return false;
+        if (m_state != State::Done)
+            return fail("unexpected end of document");
+        return true;
+    }
+
+    bool Parser::done() const
+    {
+        return m_state == State::Done;
+    }
+
+    const char *Parser::error() const
+    {
+        return m_error;
+    }
+
+    size_t Parser::offset() const
+    {
+        return m_offset;
+    }
+
+    void Parser::reset()
+    {
+        m_state = State::Value;
+        m_error = nullptr;
+        m_offset = 0;
+        m_depth = 0;
+        m_tokenSize = 0;
+        m_highSurrogate = 0;
+    }
+
+    bool Parser::fail(const char *error)
+    {
+        m_error = error;
+        return false;
+    }
+
+    bool Parser::push(char bracket)
+    {
+        if (m_depth == DEPTH_MAX)
+            return fail("nested too deeply");
+        m_stack[m_depth++] = bracket;
+        return true;
+    }
+
+    void Parser::endValue()
+    {
+        m_state = (m_depth == 0 ? State::Done : State::AfterValue);
+    }
+
+    bool Parser::endNumber()
+    {
+        m_token[m_tokenSize] = '\0';
+        if (!validNumber(m_token))
+            return fail("invalid number");
+        m_handler.number(strtod(m_token, nullptr));
+        endValue();
+        return true;
+    }
+
+    void Parser::stringPiece(const char *data, size_t size)
+    {
+        if (size == 0)
+            return;
+
+        if (!m_isKey)
+        {
+            m_handler.string(data, size, false);
+            return;
+        }
+
+        // keys are only compared, so anything past the buffer is dropped
+        for (size_t i = 0; i < size && m_tokenSize < TOKEN_MAX; i++)
+            m_token[m_tokenSize++] = data[i];
+    }
+
+    void Parser::codePoint(unsigned int cp)
+    {
+        if (cp >= 0xDC00 && cp <= 0xDFFF && m_highSurrogate != 0)
+        {
+            cp = 0x10000 + ((m_highSurrogate - 0xD800) << 10) + (cp - 0xDC00);
+            m_highSurrogate = 0;
+        }
+        else
+        {
+            dropSurrogate();
+            if (cp >= 0xD800 && cp <= 0xDBFF)
+            {
+                // wait for the low half
+                m_highSurrogate = cp;
+                return;
+            }
+            if (cp >= 0xDC00 && cp <= 0xDFFF)
+            {
+                stringPiece(REPLACEMENT, 3);
+                return;
+            }
+        }
+
+        char utf8[4];
+        size_t size;
+        if (cp < 0x80)
+        {
+            utf8[0] = cp;
+            size = 1;
+        }
+        else if (cp < 0x800)
+        {
+            utf8[0] = 0xC0 | (cp >> 6);
+            utf8[1] = 0x80 | (cp & 0x3F);
+            size = 2;
+        }
+        else if (cp < 0x10000)
+        {
+            utf8[0] = 0xE0 | (cp >> 12);
+            utf8[1] = 0x80 | ((cp >> 6) & 0x3F);
+            utf8[2] = 0x80 | (cp & 0x3F);
+            size = 3;
+        }
+        else
+        {
+            utf8[0] = 0xF0 | (cp >> 18);
+            utf8[1] = 0x80 | ((cp >> 12) & 0x3F);
+            utf8[2] = 0x80 | ((cp >> 6) & 0x3F);
+            utf8[3] = 0x80 | (cp & 0x3F);
+            size = 4;
+        }
+        stringPiece(utf8, size);
+    }
+
+    void Parser::dropSurrogate()
+    {
+        if (m_highSurrogate == 0)
+            return;
+        m_highSurrogate = 0;
+        stringPiece(REPLACEMENT, 3);
+    }
+} // namespace json
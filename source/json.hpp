@@ -0,0 +1,96 @@
+#pragma once
+#include <cstddef>
+
+namespace json
+{
+    // Receives the document as it is parsed, override the events you need.
+    // Nothing is kept once an event returns, so no tree is ever built.
+    class Handler
+    {
+    public:
+        virtual ~Handler() = default;
+
+        virtual void beginObject() {}
+        virtual void endObject() {}
+        virtual void beginArray() {}
+        virtual void endArray() {}
+        // keys longer than Parser::TOKEN_MAX are truncated
+        virtual void key(const char *key, size_t size) {}
+        // string values arrive in pieces as chunks are fed, the final (possibly empty) piece has last set
+        virtual void string(const char *data, size_t size, bool last) {}
+        virtual void number(double value) {}
+        virtual void boolean(bool value) {}
+        virtual void null() {}
+    };
+
+    // Incremental parser fed with chunks of any size (e.g. straight from a curl write callback).
+    // Memory use is fixed: a small buffer for keys and numbers, and one byte per nesting level.
+    class Parser
+    {
+    public:
+        static constexpr size_t TOKEN_MAX = 64;
+        static constexpr size_t DEPTH_MAX = 32;
+
+        explicit Parser(Handler &handler);
+
+        // parse the next chunk, returns false once the document is invalid
+        bool feed(const char *data, size_t size);
+        // call after the last chunk, returns false if the document is invalid or was cut short
+        bool end();
+        // true once a whole top level value has been parsed
+        bool done() const;
+        // nullptr unless the document was invalid
+        const char *error() const;
+        // bytes consumed so far (the position of the error if there was one)
+        size_t offset() const;
+        void reset();
+
+    private:
+        enum class State
+        {
+            Value,
+            FirstValue,  // after '[', a value or ']'
+            FirstKey,    // after '{', a key or '}'
+            Key,         // after ',' in an object
+            Colon,
+            AfterValue,  // ',' or the end of the container
+            String,
+            Escape,
+            Unicode,
+            Literal,
+            Number,
+            Done,
+        };
+
+        bool fail(const char *error);
+        bool push(char bracket);
+        void endValue();
+        bool endNumber();
+        void stringPiece(const char *data, size_t size);
+        void codePoint(unsigned int cp);
+        void dropSurrogate();
+
+        Handler &m_handler;
+        State m_state = State::Value;
+        const char *m_error = nullptr;
+        size_t m_offset = 0;
+
+        // '{' or '[' for each open container
+        char m_stack[DEPTH_MAX];
+        size_t m_depth = 0;
+
+        // key or number being read
+        char m_token[TOKEN_MAX];
+        size_t m_tokenSize = 0;
+        bool m_isKey = false;
+
+        // \uXXXX escapes, including a high surrogate waiting for its pair
+        unsigned int m_unicode = 0;
+        unsigned int m_unicodeDigits = 0;
+        unsigned int m_highSurrogate = 0;
+
+        // true, false or null
+        const char *m_literal = nullptr;
+        size_t m_literalPos = 0;
+    };
+} // namespace json
@@ -1,3 +1,9 @@
 #include "app.hpp"
 
-int main() { Application::run(); }
+int main()
+{
+    // Startup phases are written here once the first frame is shown
+    Aether::Trace::setFile("startup_trace.log");
+    Aether::Trace::mark("main");
+    Application::run();
+}
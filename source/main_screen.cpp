@@ -1,31 +1,86 @@
 #include "main_screen.hpp"
 #include "app.hpp"
-#include "requests.hpp"
+#include "arm_disassembler.hpp"
+#include "assembler.hpp"
+#include <cinttypes>
 
 MainScreen::MainScreen()
 {
-    auto *titleText = new Aether::Text(TITLE_X, TITLE_Y, "SeedHack", TITLE_SIZE);
-    titleText->setColour(Aether::Colour{200, 250, 200, 255});
+    // the screen's elements are allocated together in its arena
+    arena().begin();
+
+    // The header never changes, so it is drawn from a cached layer
+    auto *header = new Aether::Stack(TITLE_X, TITLE_Y, 0, 0, Aether::Direction::Horizontal);
+    header->setFitContent(true);
+    header->setGap(consts::GAP_SIZE);
+    header->setAlign(Aether::Align::End);
+    header->setCached(true);
 
-    addElement(titleText);
+    auto *titleText = new Aether::Text(0, 0, "SeedHack", TITLE_SIZE);
+    titleText->setColour(Aether::Colour{200, 250, 200, 255});
+    header->addElement(titleText);
 
-    auto *subTitleText = new Aether::Text(TITLE_X + consts::GAP_SIZE + titleText->w(), 0, "Do no evil.", SUB_TITLE_SIZE);
-    subTitleText->setY(TITLE_Y + titleText->h() - subTitleText->h() - SUB_TITLE_RAISE);
+    auto *subTitleText = new Aether::Text(0, 0, "Do no evil.", SUB_TITLE_SIZE);
     subTitleText->setColour(SUB_TITLE_COLOR);
-    addElement(subTitleText);
+    header->addElement(subTitleText);
+    addElement(header);
 
     // Controls
     auto *controls = new Aether::Controls();
     controls->addItem(new Aether::ControlItem(Aether::Button::A, "OK"));
     controls->addItem(new Aether::ControlItem(Aether::Button::X, "Refresh"));
-    // onButtonPress(Aether::Button::X, [this]() { this->refreshFileList(); });
     controls->addItem(new Aether::ControlItem(Aether::Button::PLUS, "Exit"));
     onButtonPress(Aether::Button::PLUS, Application::exitApp);
     addElement(controls);
-    requests::request();
+
+    // Show a placeholder in place of the listing while the request is made (it never blocks the UI thread)
+    auto *loadingText = new Aether::Text(LIST_X, LIST_Y, "Loading...", SUB_TITLE_SIZE);
+    loadingText->setColour(Aether::Theme::Dark.mutedText);
+    addElement(loadingText);
+
+    // The assembled ARM64 patch disassembled back, to check it does what was meant
+    auto *listing = new Aether::VirtualList(LIST_X, LIST_Y, LIST_W, LIST_H, LISTING_ROW_H, LISTING_SIZE);
+    addElement(listing);
+
+    auto refresh = [loadingText, listing]() {
+        loadingText->setHidden(false);
+        listing->setHidden(true);
+        listing->setRows(0, nullptr);
+        // one instruction for each arch
+        auto remaining = std::make_shared<int>(requests::ARCH_COUNT);
+        for (auto arch : {requests::Arch::Arm64, requests::Arch::Arm, requests::Arch::Thumb})
+        {
+            requests::Assembler::getInstance().assemble("NOP", arch, "", [loadingText, listing, arch, remaining](const requests::Assembled &result) {
+                if (arch == requests::Arch::Arm64 && result.ok)
+                    showListing(listing, result.text, 0);
+                if (--*remaining == 0)
+                {
+                    loadingText->setHidden(true);
+                    listing->setHidden(false);
+                }
+            });
+        }
+    };
+    onButtonPress(Aether::Button::X, refresh);
+    arena().end();
+    refresh();
 }
 
-MainScreen::~MainScreen()
+void MainScreen::showListing(Aether::VirtualList *listing, const std::string &hex, uint64_t address)
 {
-    // the parent descructor will clean everything up for us as long is the element is added to the screen
+    auto code = std::make_shared<std::vector<uint8_t>>();
+    if (!arm::parseHex(hex, code.get()))
+        return;
+
+    // only the rows on screen are ever disassembled
+    listing->setRows(code->size() / 4, [code, address](size_t row) {
+        const auto *bytes = code->data() + row * 4;
+        uint32_t word = bytes[0] | bytes[1] << 8 | bytes[2] << 16 | static_cast<uint32_t>(bytes[3]) << 24;
+        char text[arm::TEXT_MAX];
+        arm::disassemble(word, address + row * 4, text);
+
+        char line[arm::TEXT_MAX + 32];
+        snprintf(line, sizeof(line), "%010" PRIX64 "  %08" PRIX32 "  %s", address + row * 4, word, text);
+        return std::string(line);
+    });
 }
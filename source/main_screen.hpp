@@ -7,7 +7,6 @@ class MainScreen : public Aether::Screen
 private:
     MainScreen();
     MainScreen(const MainScreen &) = delete;
-    ~MainScreen();
 
     static constexpr auto SUB_TITLE_COLOR = Aether::Colour{0xFF, 0x71, 0xE7, 0xFF};
 
@@ -16,7 +15,6 @@ private:
     static constexpr auto TITLE_Y = 50;
     static constexpr auto TITLE_SIZE = 72;
 
-    static constexpr auto SUB_TITLE_RAISE = 3;
     static constexpr auto SUB_TITLE_SIZE = 31;
 
     static constexpr auto LIST_X = 58;
@@ -24,6 +22,12 @@ private:
     static constexpr auto LIST_W = 720;
     static constexpr auto LIST_H = consts::SCREEN_H - LIST_Y - consts::CONTROL_BAR_H;
 
+    static constexpr auto LISTING_ROW_H = 36;
+    static constexpr auto LISTING_SIZE = 22;
+
+    // shows the disassembly of hex (as the assembler gives it) starting at address
+    static void showListing(Aether::VirtualList *listing, const std::string &hex, uint64_t address);
+
 public:
     static inline auto &getInstance()
     {
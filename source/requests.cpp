@@ -1,52 +1,143 @@
 #include "requests.hpp"
+#include "consts.hpp"
+#include "file_writer.hpp"
+#include <cstdio>
 #include <cstring>
-#include <curl/curl.h>
-#include <switch.h>
 
-typedef struct
+namespace requests
 {
-    u_int8_t *data;
-    size_t data_size;
-    u_int64_t offset;
-    FILE *out;
-} ntwrk_struct_t;
+    // timings of the most recent requests (UI thread only), kept in memory until writeTimings()
+    auto constexpr TIMINGS_MAX = 64;
+    auto constexpr TIMING_SIZE = 224;
+    static char s_timings[TIMINGS_MAX][TIMING_SIZE];
+    static size_t s_timingCount = 0;    // every request so far, only the last TIMINGS_MAX are kept
 
-void requests::request()
-{
-    CURL *curl;
-    CURLcode response;
-    curl = curl_easy_init();
-
-    if (curl)
+    // as a JSON string
+    static std::string quote(const std::string &s)
     {
-        FILE *fp = fopen("response.json", "wb");
-        if (fp)
+        std::string out = "\"";
+        for (char c : s)
         {
-            curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "POST");
-            curl_easy_setopt(curl, CURLOPT_URL, "https://armconverter.com/api/convert");
-            curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
-            curl_easy_setopt(curl, CURLOPT_DEFAULT_PROTOCOL, "https");
-            const char *data = "{\"asm\": \"NOP\", \"offset\": \"\", \"arch\": [\"arm64\", \"arm\", \"thumb\"]}";
-            curl_easy_setopt(curl, CURLOPT_POSTFIELDS, data);
-            response = curl_easy_perform(curl);
+            if (c == '"' || c == '\\')
+            {
+                out += '\\';
+                out += c;
+            }
+            else if (c == '\n')
+                out += "\\n";
+            else if (static_cast<unsigned char>(c) < 0x20)
+            {
+                char escaped[8];
+                snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                out += escaped;
+            }
+            else
+                out += c;
         }
+        return out + '"';
     }
-    curl_easy_cleanup(curl);
-}
 
-static size_t buffer_writer(char *ptr, size_t size, size_t nmemb, void *stream)
-{
-    ntwrk_struct_t *data_struct = (ntwrk_struct_t *)stream;
-    size_t realsize = size * nmemb;
+    // whether url points at this machine or the local network (IPv4 private ranges), the only places
+    // a stand-in server with a self-signed certificate can be
+    static bool isLocal(const std::string &url)
+    {
+        size_t start = url.find("://");
+        start = (start == std::string::npos ? 0 : start + 3);
+        std::string authority = url.substr(start, url.find_first_of("/?#", start) - start);
+        // user info could hide the real host
+        if (authority.find('@') != std::string::npos)
+            return false;
+        if (authority == "[::1]" || authority.compare(0, 6, "[::1]:") == 0)
+            return true;
+        std::string host = authority.substr(0, authority.find(':'));
+        if (host == "localhost")
+            return true;
+
+        unsigned int a, b, c, d;
+        char extra;
+        if (sscanf(host.c_str(), "%u.%u.%u.%u%c", &a, &b, &c, &d, &extra) != 4 || a > 255 || b > 255 || c > 255 || d > 255)
+            return false;
+        return a == 127 || a == 10 || (a == 172 && b >= 16 && b <= 31) || (a == 192 && b == 168);
+    }
+
+    struct Endpoint
+    {
+        std::string url = consts::API_URL;
+        bool verifyPeer = true;
+    };
+
+    // read once, so the file can be dropped on the SD card without a rebuild
+    static const Endpoint &endpoint()
+    {
+        static const Endpoint s_endpoint = []() {
+            Endpoint e;
+            std::unique_ptr<FILE, int (*)(FILE *)> file(fopen(consts::API_URL_PATH, "r"), fclose);
+            char line[512];
+            if (!file || fgets(line, sizeof(line), file.get()) == nullptr)
+                return e;
+
+            char *end = line + strcspn(line, " \t\r\n");
+            if (end == line)
+                return e;
+            // the only option is the word "insecure" on its own
+            char *option = end + strspn(end, " \t");
+            size_t length = strcspn(option, " \t\r\n");
+            bool insecure = (length == 8 && strncmp(option, "insecure", length) == 0 && option[length + strspn(option + length, " \t\r\n")] == '\0');
+            *end = '\0';
+            e.url = line;
+            e.verifyPeer = !(insecure && isLocal(e.url));
+            return e;
+        }();
+        return s_endpoint;
+    }
 
-    if (realsize + data_struct->offset >= data_struct->data_size)
+    void request(const std::string &assembly, const std::string &offset, const std::vector<Arch> &archs, Callback done)
     {
-        fwrite(data_struct->data, data_struct->offset, 1, data_struct->out);
-        data_struct->offset = 0;
+        http::Request req;
+        req.url = endpoint().url;
+        req.verifyPeer = endpoint().verifyPeer;
+        req.method = "POST";
+        req.body = "{\"asm\": " + quote(assembly) + ", \"offset\": " + quote(offset) + ", \"arch\": [";
+        for (size_t i = 0; i < archs.size(); i++)
+            req.body += (i == 0 ? "\"" : ", \"") + std::string(ARCH_NAMES[static_cast<int>(archs[i])]) + "\"";
+        req.body += "]}";
+
+        // parsed on the I/O thread as it arrives, then handed to done
+        auto parser = std::make_shared<ResultParser>(1);
+        req.onData = [parser](const char *data, size_t size) { return parser->feed(data, size); };
+
+        http::Client::getInstance().send(std::move(req), [done, parser](const http::Response &res) {
+            // the first request pays for DNS, TCP and TLS, later ones should reuse them
+            snprintf(s_timings[s_timingCount++ % TIMINGS_MAX], TIMING_SIZE, "request: %ld new connections, connect %.1f ms, tls %.1f ms, first byte %.1f ms, total %.1f ms, %zu bytes (%zu on the wire, %zu copied)",
+                     res.connects, res.connectUs / 1000.0, res.tlsUs / 1000.0, res.firstByteUs / 1000.0, res.totalUs / 1000.0, res.bytesReceived, res.wireBytes, res.bytesCopied);
+
+            if (res.ok())
+                parser->end();
+            if (done)
+                done(res, *parser);
+        });
     }
 
-    memcpy(&data_struct->data[data_struct->offset], ptr, realsize);
-    data_struct->offset += realsize;
-    data_struct->data[data_struct->offset] = 0;
-    return realsize;
-}
\ No newline at end of file
+    void writeTimings()
+    {
+        std::string text;
+        size_t first = (s_timingCount > TIMINGS_MAX ? s_timingCount - TIMINGS_MAX : 0);
+        for (size_t i = first; i < s_timingCount; i++)
+        {
+            text += s_timings[i % TIMINGS_MAX];
+            text += '\n';
+        }
+
+        // running totals, to compare networking changes over many requests
+        auto stats = http::Client::getInstance().stats();
+        if (stats.requests > 0)
+        {
+            char totals[TIMING_SIZE];
+            snprintf(totals, sizeof(totals), "requests: %zu (%zu failed), %.1f/s, first byte %.1f ms, total %.1f ms and %zu bytes copied per request, %zu/%zu bytes on the wire/decoded\n",
+                     stats.requests, stats.failed, stats.requestsPerSecond(), stats.firstByteUs / 1000.0 / stats.requests,
+                     stats.totalUs / 1000.0 / stats.requests, stats.bytesCopied / stats.requests, stats.wireBytes, stats.bytesReceived);
+            text += totals;
+        }
+        io::FileWriter::getInstance().writeFile(consts::REQUEST_LOG_PATH, text, io::Mode::Truncate);
+    }
+}
@@ -1,7 +1,16 @@
 #pragma once
-#include <cstddef>
+#include "arch.hpp"
+#include "http.hpp"
+#include "result_parser.hpp"
 
 namespace requests {
-    void request();
-    size_t buffer_writer(char*, size_t, size_t, void*);
-}
\ No newline at end of file
+    using Callback = std::function<void(const http::Response &, const ResultParser &)>;
+
+    // assemble one or more lines (separated by '\n') for each arch, starting at offset (hex, may be empty)
+    // done is called on the UI thread once the response has arrived
+    void request(const std::string &assembly, const std::string &offset, const std::vector<Arch> &archs, Callback done);
+
+    // writes the timings of the most recent requests and the running totals to consts::REQUEST_LOG_PATH
+    // (through io::FileWriter), call from the UI thread
+    void writeTimings();
+}
@@ -0,0 +1,144 @@
+#include "result_parser.hpp"
+#include <cstring>
+
+namespace requests
+{
+    static bool equals(const char *key, size_t size, const char *name)
+    {
+        return strlen(name) == size && memcmp(key, name, size) == 0;
+    }
+
+    void Field::append(const char *data, size_t length)
+    {
+        size_t room = FIELD_MAX - 1 - size;
+        if (length > room)
+        {
+            length = room;
+            truncated = true;
+        }
+        memcpy(text + size, data, length);
+        size += length;
+        text[size] = '\0';
+    }
+
+    ResultParser::ResultParser(size_t capacity) : m_parser(*this), m_results(capacity) {}
+
+    bool ResultParser::feed(const char *data, size_t size)
+    {
+        return m_parser.feed(data, size);
+    }
+
+    bool ResultParser::end()
+    {
+        return m_parser.end();
+    }
+
+    void ResultParser::beginObject()
+    {
+        m_depth++;
+        if (m_current == nullptr && (m_depth == 1 || (m_depth == 2 && m_rootArray)))
+        {
+            // a new result, reusing the preallocated slot
+            m_base = m_depth;
+            m_key = Key::Other;
+            if (m_count < m_results.size())
+            {
+                m_current = &m_results[m_count++];
+                *m_current = Result();
+            }
+            else
+                m_dropped++;
+        }
+        else if (m_current != nullptr && m_depth == m_base + 1 && m_key == Key::Hex)
+        {
+            m_inHex = true;
+            m_arch = -1;
+        }
+    }
+
+    void ResultParser::endObject()
+    {
+        if (m_current != nullptr && m_depth == m_base)
+            m_current = nullptr;
+        else if (m_inHex && m_depth == m_base + 1)
+            m_inHex = false;
+        m_depth--;
+    }
+
+    void ResultParser::beginArray()
+    {
+        m_depth++;
+        if (m_depth == 1)
+            m_rootArray = true;
+        else if (m_inHex && m_arch >= 0 && m_depth == m_base + 2)
+            m_inPair = true;
+    }
+
+    void ResultParser::endArray()
+    {
+        if (m_inPair && m_depth == m_base + 2)
+            m_inPair = false;
+        m_depth--;
+    }
+
+    void ResultParser::key(const char *key, size_t size)
+    {
+        if (m_current == nullptr)
+            return;
+
+        if (m_depth == m_base)
+        {
+            if (equals(key, size, "hex"))
+                m_key = Key::Hex;
+            else if (equals(key, size, "error"))
+                m_key = Key::Error;
+            else
+                m_key = Key::Other;
+        }
+        else if (m_inHex && m_depth == m_base + 1)
+        {
+            m_arch = -1;
+            for (int i = 0; i < ARCH_COUNT; i++)
+            {
+                if (equals(key, size, ARCH_NAMES[i]))
+                    m_arch = i;
+            }
+        }
+    }
+
+    void ResultParser::string(const char *data, size_t size, bool last)
+    {
+        if (m_current != nullptr && m_depth == m_base && m_key == Key::Error)
+        {
+            m_current->error.append(data, size);
+            return;
+        }
+
+        auto *enc = encoding();
+        if (enc == nullptr)
+            return;
+        // a plain string instead of [ok, text] is the hex on its own
+        if (!m_inPair)
+            enc->ok = true;
+        enc->present = true;
+        enc->text.append(data, size);
+    }
+
+    void ResultParser::boolean(bool value)
+    {
+        auto *enc = encoding();
+        if (enc == nullptr || !m_inPair)
+            return;
+        enc->present = true;
+        enc->ok = value;
+    }
+
+    Encoding *ResultParser::encoding()
+    {
+        if (m_current == nullptr || !m_inHex || m_arch < 0)
+            return nullptr;
+        if (m_depth != m_base + 1 && !(m_inPair && m_depth == m_base + 2))
+            return nullptr;
+        return &m_current->arch[m_arch];
+    }
+} // namespace requests
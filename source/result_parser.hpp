@@ -0,0 +1,85 @@
+#pragma once
+#include "arch.hpp"
+#include "json.hpp"
+#include <vector>
+
+namespace requests
+{
+    // longest hex string or message kept for each field, the rest is dropped
+    // (fits a full batch of the longest encodings, see Assembler)
+    auto constexpr FIELD_MAX = 1024;
+
+    struct Field
+    {
+        char text[FIELD_MAX] = {};    // always NUL terminated
+        size_t size = 0;
+        bool truncated = false;
+
+        void append(const char *data, size_t length);
+    };
+
+    struct Encoding
+    {
+        bool present = false;    // the arch was in the response
+        bool ok = false;
+        Field text;              // hex when ok, otherwise the assembler's error
+    };
+
+    struct Result
+    {
+        Encoding arch[ARCH_COUNT];
+        Field error;             // "error" of the whole request, if any
+    };
+
+    // Fills preallocated results while the response streams in, without keeping the body.
+    // Takes one result object or an array of them (one per batched instruction).
+    class ResultParser : public json::Handler
+    {
+    public:
+        explicit ResultParser(size_t capacity);
+
+        // give to Request::onData, returns false once the response can't be parsed
+        bool feed(const char *data, size_t size);
+        // call once the transfer has finished
+        bool end();
+
+        const Result *results() const { return m_results.data(); }
+        size_t count() const { return m_count; }
+        // results beyond the capacity which were skipped
+        size_t dropped() const { return m_dropped; }
+        // nullptr unless the response wasn't valid JSON
+        const char *error() const { return m_parser.error(); }
+
+    private:
+        enum class Key
+        {
+            Other,
+            Error,
+            Hex,
+        };
+
+        void beginObject() override;
+        void endObject() override;
+        void beginArray() override;
+        void endArray() override;
+        void key(const char *key, size_t size) override;
+        void string(const char *data, size_t size, bool last) override;
+        void boolean(bool value) override;
+        Encoding *encoding();
+
+        json::Parser m_parser;
+        std::vector<Result> m_results;
+        size_t m_count = 0;
+        size_t m_dropped = 0;
+
+        // where the parser is: depth of open containers, and of the result object being filled
+        Result *m_current = nullptr;
+        size_t m_depth = 0;
+        size_t m_base = 0;
+        bool m_rootArray = false;
+        Key m_key = Key::Other;
+        bool m_inHex = false;
+        int m_arch = -1;
+        bool m_inPair = false;    // inside [ok, "hex or error"]
+    };
+} // namespace requests
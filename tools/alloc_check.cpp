@@ -0,0 +1,163 @@
+// Host allocation checks for Aether's event dispatch and ElementArena:
+//   make -C tools alloc_check && tools/alloc_check [--elements N]
+// Counts calls to the global operator new (the rendering side is stubbed out by host/headless.cpp):
+//  - once warmed up, dispatching button and touch events through a screen must not allocate
+//  - building a tree inside an ElementArena must not allocate the elements themselves
+#include "Aether/Screen.hpp"
+#include "Aether/utils/ElementArena.hpp"
+#include "alloc_count.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// grid of touchable, selectable elements with button callbacks, like a screen of buttons
+class TestScreen : public Aether::Screen
+{
+public:
+    size_t pressed = 0;
+    size_t released = 0;
+    size_t clicked = 0;
+
+    TestScreen()
+    {
+        for (int i = 0; i < 12; i++)
+        {
+            Aether::Element *e = new Aether::Element(100 + (i % 4) * 250, 100 + (i / 4) * 150, 200, 100);
+            e->setSelectable(true);
+            e->setTouchable(true);
+            e->setCallback([this]() { clicked++; });
+            addElement(e);
+        }
+        onButtonPress(Aether::Button::B, [this]() { pressed++; });
+        onButtonRelease(Aether::Button::B, [this]() { released++; });
+    }
+};
+
+static SDL_Event finger(Uint32 type, float x, float y, float dx, float dy)
+{
+    SDL_Event event;
+    std::memset(&event, 0, sizeof(event));
+    event.type = type;
+    event.tfinger.x = x / 1280;
+    event.tfinger.y = y / 720;
+    event.tfinger.dx = dx / 1280;
+    event.tfinger.dy = dy / 720;
+    return event;
+}
+
+// one frame's worth of input: screen callbacks, focus movement, element callbacks and a tap
+static void dispatchRound(TestScreen &screen)
+{
+    Aether::InputEvent events[] = {
+        Aether::InputEvent(Aether::EventType::ButtonPressed, Aether::Button::B, 0),
+        Aether::InputEvent(Aether::EventType::ButtonReleased, Aether::Button::B, 0),
+        Aether::InputEvent(Aether::EventType::ButtonPressed, Aether::Button::DPAD_RIGHT, 0),
+        Aether::InputEvent(Aether::EventType::ButtonReleased, Aether::Button::DPAD_RIGHT, 0),
+        Aether::InputEvent(Aether::EventType::ButtonPressed, Aether::Button::A, 0),
+        Aether::InputEvent(Aether::EventType::ButtonReleased, Aether::Button::A, 0),
+        Aether::InputEvent(finger(SDL_FINGERDOWN, 450, 250, 0, 0)),
+        Aether::InputEvent(finger(SDL_FINGERMOTION, 452, 251, 2, 1)),
+        Aether::InputEvent(finger(SDL_FINGERUP, 452, 251, 0, 0)),
+    };
+    for (Aether::InputEvent &event : events)
+        screen.handleEvent(&event);
+    screen.update(16);
+}
+
+static bool checkDispatch(size_t rounds)
+{
+    TestScreen screen;
+    dispatchRound(screen);
+
+    size_t before = allocations;
+    for (size_t i = 0; i < rounds; i++)
+        dispatchRound(screen);
+    size_t count = allocations - before;
+
+    printf("dispatch: %zu rounds, %zu allocations (%zu presses, %zu releases, %zu clicks)\n", rounds, count,
+           screen.pressed, screen.released, screen.clicked);
+    if (screen.pressed != rounds + 1 || screen.released != rounds + 1 || screen.clicked == 0)
+    {
+        printf("FAIL: events didn't reach their callbacks\n");
+        return false;
+    }
+    if (count != 0)
+    {
+        printf("FAIL: steady-state dispatch allocated\n");
+        return false;
+    }
+    return true;
+}
+
+// builds a container of n elements, returning the number of allocations it took
+static size_t buildTree(Aether::Container &root, size_t n)
+{
+    size_t before = allocations;
+    for (size_t i = 0; i < n; i++)
+    {
+        Aether::Element *e = new Aether::Element((i % 32) * 40, (i / 32) * 40, 40, 40);
+        e->setTouchable(true);
+        root.addElement(e);
+    }
+    return allocations - before;
+}
+
+static bool checkArena(size_t elements)
+{
+    Aether::Container heapRoot(0, 0, 1280, 720);
+    size_t heap = buildTree(heapRoot, elements);
+    heapRoot.removeAllElements();
+
+    // twice, as the second build reuses the first one's blocks
+    Aether::ElementArena arena;
+    Aether::Container arenaRoot(0, 0, 1280, 720);
+    size_t first = 0;
+    size_t second = 0;
+    for (size_t *count : {&first, &second})
+    {
+        arena.begin();
+        *count = buildTree(arenaRoot, elements);
+        arena.end();
+        if (arena.liveCount() != elements)
+        {
+            printf("FAIL: arena holds %zu elements, expected %zu\n", arena.liveCount(), elements);
+            return false;
+        }
+        arenaRoot.removeAllElements();
+    }
+
+    printf("tree of %zu elements: heap %zu allocations, arena %zu then %zu\n", elements, heap, first, second);
+    if (arena.liveCount() != 0)
+    {
+        printf("FAIL: arena still holds %zu elements after they were removed\n", arena.liveCount());
+        return false;
+    }
+    // what's left is the containers' own bookkeeping (children, spatial index), never the elements
+    // (checked on the second build, as the first also grows the arena's list of blocks)
+    if (second + elements > heap)
+    {
+        printf("FAIL: elements were allocated on the heap inside the arena\n");
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    size_t elements = 2000;
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--elements") && i + 1 < argc)
+            elements = strtoull(argv[++i], nullptr, 10);
+        else
+        {
+            fprintf(stderr, "usage: %s [--elements N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    bool ok = checkDispatch(1000);
+    ok = checkArena(elements) && ok;
+    printf(ok ? "ok\n" : "FAILED\n");
+    return ok ? 0 : 1;
+}
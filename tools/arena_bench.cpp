@@ -0,0 +1,97 @@
+// Host benchmark for rebuilding element trees on the heap and in a screen's ElementArena:
+//   make -C tools arena_bench && tools/arena_bench [--rows N] [--rounds N]
+// Each round deletes a screen's elements and builds them again (rows of a container holding a text and
+// an element), the way a screen's onLoad() or a task's done() rebuilds it, then resizes a VirtualList
+// so it recreates its slots. Reports the time and operator new calls per rebuild.
+#include "Aether/Screen.hpp"
+#include "Aether/horizon/list/VirtualList.hpp"
+#include "alloc_count.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+class BenchScreen : public Aether::Screen
+{
+public:
+    void build(size_t rows)
+    {
+        for (size_t i = 0; i < rows; i++)
+        {
+            Aether::Container *row = new Aether::Container(0, i * 40, 1280, 40);
+            row->addElement(new Aether::Text(10, i * 40, "Row " + std::to_string(i), 20));
+            Aether::Element *button = new Aether::Element(1000, i * 40, 200, 40);
+            button->setSelectable(true);
+            button->setTouchable(true);
+            row->addElement(button);
+            addElement(row);
+        }
+    }
+};
+
+struct Result
+{
+    double us;
+    double allocations;
+};
+
+template <typename F>
+static Result measure(size_t rounds, F &&round)
+{
+    round();
+    size_t before = allocations;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < rounds; i++)
+        round();
+    auto end = std::chrono::steady_clock::now();
+    return Result{std::chrono::duration<double, std::micro>(end - start).count() / rounds,
+                  static_cast<double>(allocations - before) / rounds};
+}
+
+static void print(const char *label, const Result &result)
+{
+    printf("%-14s %10.1f us/rebuild %10.1f allocations/rebuild\n", label, result.us, result.allocations);
+}
+
+int main(int argc, char **argv)
+{
+    size_t rows = 500;
+    size_t rounds = 200;
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--rows") && i + 1 < argc)
+            rows = strtoull(argv[++i], nullptr, 10);
+        else if (!strcmp(argv[i], "--rounds") && i + 1 < argc)
+            rounds = strtoull(argv[++i], nullptr, 10);
+        else
+        {
+            fprintf(stderr, "usage: %s [--rows N] [--rounds N]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (rounds == 0)
+        rounds = 1;
+
+    BenchScreen screen;
+    printf("screen of %zu rows (%zu elements), %zu rounds\n", rows, rows * 3, rounds);
+    print("heap", measure(rounds, [&]() {
+              screen.removeAllElements();
+              screen.build(rows);
+          }));
+    print("arena", measure(rounds, [&]() {
+              screen.removeAllElements();
+              Aether::ElementArena::Scope scope(screen.arena());
+              screen.build(rows);
+          }));
+    screen.removeAllElements();
+
+    // the slots come from the list's own arena
+    Aether::VirtualList list(0, 0, 1280, 720, 20, 16);
+    bool tall = false;
+    print("list resize", measure(rounds, [&]() {
+              tall = !tall;
+              list.setH(tall ? 720 : 700);
+          }));
+    return 0;
+}
@@ -0,0 +1,138 @@
+// Host benchmark for io::FileWriter against writing directly with stdio from the calling thread:
+//   make -C tools file_writer_bench && tools/file_writer_bench [--dir DIR] [--mb N] [--sync]
+// Each case writes the same data both ways: many small writes to one file (like a log), large writes
+// to one file (like a response body) and many small files (like exported patches). Reports how long
+// the caller was blocked and the throughput up to the data being written (fsync'd with --sync).
+#include "file_writer.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+static double msSince(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+struct Case
+{
+    const char *name;
+    size_t files;
+    size_t writes;  // per file
+    size_t size;    // per write
+};
+
+struct Result
+{
+    double blockedMs;   // time spent inside the write calls
+    double totalMs;     // until everything is written (and synced)
+    bool ok;
+};
+
+static std::string path(const std::string &dir, size_t i)
+{
+    return dir + "/file_writer_bench_" + std::to_string(i) + ".bin";
+}
+
+static Result direct(const Case &c, const std::string &dir, const std::string &chunk, bool sync)
+{
+    Result result{0, 0, true};
+    auto start = Clock::now();
+    for (size_t f = 0; f < c.files; f++)
+    {
+        auto blocked = Clock::now();
+        FILE *fp = fopen(path(dir, f).c_str(), "wb");
+        if (fp == nullptr)
+            return Result{0, 0, false};
+        for (size_t i = 0; i < c.writes; i++)
+            result.ok = fwrite(chunk.data(), 1, c.size, fp) == c.size && result.ok;
+        if (sync)
+            result.ok = fflush(fp) == 0 && fsync(fileno(fp)) == 0 && result.ok;
+        result.ok = fclose(fp) == 0 && result.ok;
+        result.blockedMs += msSince(blocked);
+    }
+    result.totalMs = msSince(start);
+    return result;
+}
+
+static Result writer(const Case &c, const std::string &dir, const std::string &chunk, bool sync)
+{
+    auto &fileWriter = io::FileWriter::getInstance();
+    Result result{0, 0, true};
+    std::atomic<bool> closed(true);   // set from the writer thread
+    auto start = Clock::now();
+    for (size_t f = 0; f < c.files; f++)
+    {
+        auto blocked = Clock::now();
+        io::FileId id = fileWriter.open(path(dir, f), io::Mode::Truncate);
+        for (size_t i = 0; i < c.writes; i++)
+            result.ok = fileWriter.write(id, chunk.data(), c.size) && result.ok;
+        fileWriter.close(id, [&closed](bool ok) {
+            if (!ok)
+                closed = false;
+        });
+        result.blockedMs += msSince(blocked);
+    }
+    fileWriter.flush(sync);
+    result.totalMs = msSince(start);
+    result.ok = result.ok && closed;
+    return result;
+}
+
+static void print(const char *how, const Case &c, const Result &r)
+{
+    double mb = static_cast<double>(c.files) * c.writes * c.size / (1024 * 1024);
+    printf("%-26s %-6s blocked %9.2f ms  total %9.2f ms  %8.1f MB/s%s\n", c.name, how, r.blockedMs, r.totalMs,
+           mb / (r.totalMs / 1000), r.ok ? "" : "  FAILED");
+}
+
+int main(int argc, char **argv)
+{
+    std::string dir = "/tmp";
+    size_t mb = 64;
+    bool sync = false;
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--dir") && i + 1 < argc)
+            dir = argv[++i];
+        else if (!strcmp(argv[i], "--mb") && i + 1 < argc)
+            mb = strtoull(argv[++i], nullptr, 10);
+        else if (!strcmp(argv[i], "--sync"))
+            sync = true;
+        else
+        {
+            fprintf(stderr, "usage: %s [--dir DIR] [--mb N] [--sync]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (mb == 0)
+        mb = 1;
+
+    size_t bytes = mb * 1024 * 1024;
+    const Case cases[] = {
+        {"small writes (128 B)", 1, bytes / 128, 128},
+        {"large writes (1 MB)", 1, mb, 1024 * 1024},
+        {"small files (4 KB each)", bytes / 4096 / 16, 1, 4096},
+    };
+    std::string chunk(1024 * 1024, 'x');
+
+    printf("%zu MB to %s%s\n", mb, dir.c_str(), sync ? " (synced)" : "");
+    bool ok = true;
+    for (const Case &c : cases)
+    {
+        Result d = direct(c, dir, chunk, sync);
+        print("stdio", c, d);
+        Result w = writer(c, dir, chunk, sync);
+        print("writer", c, w);
+        ok = ok && d.ok && w.ok;
+        for (size_t f = 0; f < c.files; f++)
+            unlink(path(dir, f).c_str());
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,33 @@
+// Headless stand-in for the parts of SDL that Aether's headers and element code use, so the
+// element, layout and list code can be built into host tests and benchmarks (see ../Makefile).
+// Only types and constants are declared, nothing here draws or receives input.
+#pragma once
+#include <cstdint>
+
+typedef uint8_t Uint8;
+typedef uint16_t Uint16;
+typedef uint32_t Uint32;
+typedef int32_t Sint32;
+typedef int64_t Sint64;
+
+typedef struct SDL_Color { Uint8 r, g, b, a; } SDL_Color;
+typedef struct SDL_Rect { int x, y, w, h; } SDL_Rect;
+typedef struct SDL_Surface { int w, h; } SDL_Surface;
+typedef struct SDL_Texture SDL_Texture;
+
+typedef enum { SDL_BLENDMODE_NONE, SDL_BLENDMODE_BLEND, SDL_BLENDMODE_ADD, SDL_BLENDMODE_MOD } SDL_BlendMode;
+
+typedef enum
+{
+    SDL_QUIT = 0x100,
+    SDL_JOYBUTTONDOWN = 0x603,
+    SDL_JOYBUTTONUP,
+    SDL_FINGERDOWN = 0x700,
+    SDL_FINGERUP,
+    SDL_FINGERMOTION,
+    SDL_USEREVENT = 0x8000,
+} SDL_EventType;
+
+typedef struct { Uint32 type; Uint32 timestamp; Sint32 which; Uint8 button; Uint8 state; } SDL_JoyButtonEvent;
+typedef struct { Uint32 type; Uint32 timestamp; Sint64 touchId; Sint64 fingerId; float x, y, dx, dy, pressure; } SDL_TouchFingerEvent;
+typedef union SDL_Event { Uint32 type; SDL_JoyButtonEvent jbutton; SDL_TouchFingerEvent tfinger; Uint8 padding[56]; } SDL_Event;
@@ -0,0 +1,11 @@
+// Headless stand-in for SDL_ttf, see SDL.h
+#pragma once
+#include <SDL2/SDL.h>
+
+typedef struct _TTF_Font TTF_Font;
+
+#define TTF_STYLE_NORMAL 0x00
+#define TTF_STYLE_BOLD 0x01
+#define TTF_STYLE_ITALIC 0x02
+#define TTF_STYLE_UNDERLINE 0x04
+#define TTF_STYLE_STRIKETHROUGH 0x08
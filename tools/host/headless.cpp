@@ -0,0 +1,57 @@
+// Headless stand-ins for the rendering half of Aether (SDLHelper and Display::wake), so element
+// trees can be built, laid out and fed events on the host. Nothing is drawn: textures and
+// surfaces are never created, and text is measured as a fixed-width font so layout still moves.
+#include "Aether/Display.hpp"
+#include "Aether/utils/SDLHelper.hpp"
+
+namespace Aether {
+    void Display::wake() {
+
+    }
+};
+
+namespace SDLHelper {
+    static int offsetX = 0;
+    static int offsetY = 0;
+    static SDL_BlendMode blendMode = SDL_BLENDMODE_BLEND;
+
+    SDL_Texture * convertSurfaceToTexture(SDL_Surface *) { return nullptr; }
+    SDL_Texture * createTexture(int, int) { return nullptr; }
+    void destroyTexture(SDL_Texture *) { }
+    void freeSurface(SDL_Surface *) { }
+
+    void getDimensions(SDL_Texture *, int * w, int * h) {
+        if (w != nullptr) *w = 0;
+        if (h != nullptr) *h = 0;
+    }
+
+    void getOffset(int * x, int * y) {
+        *x = offsetX;
+        *y = offsetY;
+    }
+
+    void setOffset(int x, int y) {
+        offsetX = x;
+        offsetY = y;
+    }
+
+    void renderToTexture(SDL_Texture *) { }
+    SDL_Texture * getRenderTarget() { return nullptr; }
+    void setRenderTarget(SDL_Texture *) { }
+    SDL_BlendMode getBlendMode() { return blendMode; }
+    void setBlendMode(SDL_BlendMode b) { blendMode = b; }
+
+    void drawFilledRect(SDL_Color, int, int, int, int) { }
+    void drawRect(SDL_Color, int, int, int, int, unsigned int) { }
+    void drawTexture(SDL_Texture *, SDL_Color, int, int, int, int, int, int, int, int) { }
+
+    SDL_Surface * renderFilledRectS(int, int) { return nullptr; }
+    SDL_Surface * renderTextS(std::string, int, int) { return nullptr; }
+    SDL_Surface * renderTextWrappedS(std::string, int, uint32_t, int) { return nullptr; }
+    SDL_Texture * renderFilledRect(int, int) { return nullptr; }
+
+    void getTextDimensions(std::string str, int font_size, int * w, int * h, int) {
+        if (w != nullptr) *w = (font_size / 2) * str.length();
+        if (h != nullptr) *h = font_size;
+    }
+};
@@ -0,0 +1,11 @@
+// Headless stand-in for the libnx types Aether's headers use, see SDL2/SDL.h
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+typedef int32_t s32;
+typedef int64_t s64;
@@ -0,0 +1,97 @@
+// Host benchmark for http::Client, the same client the app uses, to run against tools/mock_api.py:
+//   make -C tools && tools/http_bench https://127.0.0.1:8443/api/convert -n 200 -c 4 --insecure
+// Reports requests per second, time to first byte and how many body bytes were copied.
+#include "http.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+static void usage(const char *name)
+{
+    printf("usage: %s URL [-n requests] [-c concurrency] [--insecure] [--identity] [--keep-body]\n", name);
+    printf("  --insecure   don't verify the certificate (self-signed stand-in server)\n");
+    printf("  --identity   don't offer gzip/deflate\n");
+    printf("  --keep-body  keep the body in Response::body instead of counting it in onData\n");
+}
+
+static void print(const char *label, const http::Stats &stats)
+{
+    size_t done = stats.requests > 0 ? stats.requests : 1;
+    printf("%-6s %6zu requests %4zu failed %10.1f req/s  ttfb %8.2f ms  total %8.2f ms  wire %9zu  decoded %9zu  copied %9zu bytes\n",
+           label, stats.requests, stats.failed, stats.requestsPerSecond(), stats.firstByteUs / 1000.0 / done,
+           stats.totalUs / 1000.0 / done, stats.wireBytes, stats.bytesReceived, stats.bytesCopied);
+}
+
+static void wait(http::Client &client)
+{
+    while (client.busy())
+    {
+        client.poll();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    client.poll();
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2 || argv[1][0] == '-')
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    http::Request request;
+    request.url = argv[1];
+    request.method = "POST";
+    request.headers.push_back("Content-Type: application/json");
+    request.body = "{\"asm\": \"nop\\nnop\\nnop\\nnop\", \"offset\": \"\", \"arch\": [\"arm64\", \"arm\", \"thumb\"]}";
+    size_t count = 100;
+    size_t concurrency = 4;
+    bool keepBody = false;
+    for (int i = 2; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+            count = strtoul(argv[++i], nullptr, 10);
+        else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc)
+            concurrency = strtoul(argv[++i], nullptr, 10);
+        else if (strcmp(argv[i], "--insecure") == 0)
+            request.verifyPeer = false;
+        else if (strcmp(argv[i], "--identity") == 0)
+            request.compressed = false;
+        else if (strcmp(argv[i], "--keep-body") == 0)
+            keepBody = true;
+        else
+        {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    size_t received = 0;
+    if (!keepBody)
+        request.onData = [&received](const char *, size_t size) {
+            received += size;
+            return true;
+        };
+
+    auto &client = http::Client::getInstance();
+    client.setMaxConcurrent(concurrency > 0 ? concurrency : 1);
+    auto report = [](const http::Response &response) {
+        if (!response.ok())
+            fprintf(stderr, "request failed: status %ld, %s\n", response.status, response.error.c_str());
+    };
+
+    // the first request pays for DNS, connecting and the TLS handshake, the rest reuse them
+    client.send(request, report);
+    wait(client);
+    print("cold", client.stats());
+
+    client.resetStats();
+    for (size_t i = 1; i < count; i++)
+        client.send(request, report);
+    wait(client);
+    print("warm", client.stats());
+    return 0;
+}
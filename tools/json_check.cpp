@@ -0,0 +1,437 @@
+// Host checks and benchmark for json::Parser and requests::ResultParser:
+//   make -C tools && tools/json_check [--seed N] [--iterations N] [--bench]
+// Every document must give the same events and the same results however it is split into chunks,
+// and mutated documents must be accepted exactly when a plain recursive validator accepts them.
+// Build with CXXFLAGS="-O1 -g -fsanitize=address,undefined" to catch memory errors as well.
+#include "json.hpp"
+#include "result_parser.hpp"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+// documents the mutations start from, valid and invalid
+static const char *SEEDS[] = {
+    R"({"asm": "NOP", "offset": "", "hex": {"arm64": [true, "1F2003D5"], "arm": [true, "00F020E3"], "thumb": [true, "00BF"]}})",
+    R"([{"hex": {"arm64": [true, "1F2003D5"]}}, {"hex": {"arm64": [false, "invalid instruction"]}}, {"error": "bad \"offset\""}])",
+    R"({"hex": {"arm64": "1F2003D5", "arm": [false, "eé\n"], "thumb": null}, "n": [-1.5e3, 0, 12.25, true, null, {}]})",
+    R"([{"a": "😀"}, [], [[1]], {"hex": {}}])",
+    R"({"hex": {"arm64": [true, "1F20)",
+    R"({"a" 1})",
+};
+
+// alphabet the mutations draw from
+static const char MUTATIONS[] = "{}[]\",:0123456789-+.eEtrufalsn \\u";
+
+// records events as text, so two parses can be compared
+class Recorder : public json::Handler
+{
+public:
+    std::string events;
+
+    void beginObject() override { events += '{'; }
+    void endObject() override { events += '}'; }
+    void beginArray() override { events += '['; }
+    void endArray() override { events += ']'; }
+    void key(const char *key, size_t size) override { events += "K(" + std::string(key, size) + ")"; }
+    void string(const char *data, size_t size, bool last) override
+    {
+        m_string.append(data, size);
+        if (!last)
+            return;
+        events += "S(" + m_string + ")";
+        m_string.clear();
+    }
+    void number(double value) override
+    {
+        char text[32];
+        snprintf(text, sizeof(text), "N(%.17g)", value);
+        events += text;
+    }
+    void boolean(bool value) override { events += value ? "T" : "F"; }
+    void null() override { events += "null"; }
+
+private:
+    std::string m_string;
+};
+
+// strict recursive descent validator with the parser's limits, used as the reference
+class Validator
+{
+public:
+    explicit Validator(const std::string &doc) : m_doc(doc) {}
+
+    bool valid()
+    {
+        space();
+        if (!value(0))
+            return false;
+        space();
+        return m_pos == m_doc.size();
+    }
+
+private:
+    int peek() const { return m_pos < m_doc.size() ? static_cast<unsigned char>(m_doc[m_pos]) : -1; }
+
+    void space()
+    {
+        while (peek() == ' ' || peek() == '\t' || peek() == '\n' || peek() == '\r')
+            m_pos++;
+    }
+
+    bool value(size_t depth)
+    {
+        switch (peek())
+        {
+        case '{':
+            return container('}', depth + 1);
+        case '[':
+            return container(']', depth + 1);
+        case '"':
+            return string();
+        case 't':
+            return literal("true");
+        case 'f':
+            return literal("false");
+        case 'n':
+            return literal("null");
+        default:
+            return number();
+        }
+    }
+
+    bool container(char close, size_t depth)
+    {
+        if (depth > json::Parser::DEPTH_MAX)
+            return false;
+        m_pos++;
+        space();
+        if (peek() == close)
+        {
+            m_pos++;
+            return true;
+        }
+        while (true)
+        {
+            if (close == '}')
+            {
+                if (peek() != '"' || !string())
+                    return false;
+                space();
+                if (peek() != ':')
+                    return false;
+                m_pos++;
+                space();
+            }
+            if (!value(depth))
+                return false;
+            space();
+            if (peek() == close)
+            {
+                m_pos++;
+                return true;
+            }
+            if (peek() != ',')
+                return false;
+            m_pos++;
+            space();
+        }
+    }
+
+    bool string()
+    {
+        m_pos++;
+        while (true)
+        {
+            int c = peek();
+            m_pos++;
+            if (c == '"')
+                return true;
+            if (c < 0x20)
+                return false;
+            if (c != '\\')
+                continue;
+            c = peek();
+            m_pos++;
+            if (c == 'u')
+            {
+                for (int i = 0; i < 4; i++, m_pos++)
+                {
+                    if (!isxdigit(peek()))
+                        return false;
+                }
+            }
+            else if (c < 0 || !strchr("\"\\/bfnrt", c))
+                return false;
+        }
+    }
+
+    bool literal(const char *text)
+    {
+        size_t size = strlen(text);
+        if (m_doc.compare(m_pos, size, text) != 0)
+            return false;
+        m_pos += size;
+        return true;
+    }
+
+    bool digits()
+    {
+        size_t start = m_pos;
+        while (isdigit(peek()))
+            m_pos++;
+        return m_pos > start;
+    }
+
+    bool number()
+    {
+        size_t start = m_pos;
+        if (peek() == '-')
+            m_pos++;
+        if (peek() == '0')
+            m_pos++;
+        else if (!digits())
+            return false;
+        if (peek() == '.')
+        {
+            m_pos++;
+            if (!digits())
+                return false;
+        }
+        if (peek() == 'e' || peek() == 'E')
+        {
+            m_pos++;
+            if (peek() == '+' || peek() == '-')
+                m_pos++;
+            if (!digits())
+                return false;
+        }
+        return m_pos - start < json::Parser::TOKEN_MAX - 1;
+    }
+
+    const std::string &m_doc;
+    size_t m_pos = 0;
+};
+
+// splits doc into random chunks of 1 to maxChunk bytes and feeds them to feed
+template <typename Feed>
+static bool feedSplit(const std::string &doc, size_t maxChunk, std::mt19937 &rng, Feed feed)
+{
+    for (size_t i = 0; i < doc.size();)
+    {
+        size_t size = std::min<size_t>(1 + rng() % maxChunk, doc.size() - i);
+        if (!feed(doc.data() + i, size))
+            return false;
+        i += size;
+    }
+    return true;
+}
+
+static bool parse(const std::string &doc, size_t maxChunk, std::mt19937 &rng, std::string *events)
+{
+    Recorder recorder;
+    json::Parser parser(recorder);
+    bool ok = feedSplit(doc, maxChunk, rng, [&parser](const char *data, size_t size) { return parser.feed(data, size); }) && parser.end();
+    *events = recorder.events;
+    return ok;
+}
+
+// the results as text, so two parses can be compared
+static std::string describe(const requests::ResultParser &parser)
+{
+    std::string text;
+    for (size_t i = 0; i < parser.count(); i++)
+    {
+        const auto &result = parser.results()[i];
+        text += "error '" + std::string(result.error.text, result.error.size) + "'";
+        for (const auto &enc : result.arch)
+            text += " [" + std::to_string(enc.present) + std::to_string(enc.ok) + " '" + std::string(enc.text.text, enc.text.size) + "']";
+        text += "\n";
+    }
+    return text + "dropped " + std::to_string(parser.dropped());
+}
+
+static bool fieldsIntact(const requests::ResultParser &parser)
+{
+    auto intact = [](const requests::Field &field) { return field.size < requests::FIELD_MAX && field.text[field.size] == '\0'; };
+    for (size_t i = 0; i < parser.count(); i++)
+    {
+        const auto &result = parser.results()[i];
+        if (!intact(result.error))
+            return false;
+        for (const auto &enc : result.arch)
+        {
+            if (!intact(enc.text))
+                return false;
+        }
+    }
+    return true;
+}
+
+// checks one document, prints what went wrong and returns false on a failure
+static bool check(const std::string &doc, std::mt19937 &rng, bool *valid)
+{
+    std::string reference;
+    bool ok = parse(doc, doc.size() + 1, rng, &reference);
+    *valid = ok;
+    if (ok != Validator(doc).valid())
+    {
+        printf("validity differs from the reference (parser says %s): %s\n", ok ? "valid" : "invalid", doc.c_str());
+        return false;
+    }
+
+    requests::ResultParser whole(4);
+    bool wholeOk = whole.feed(doc.data(), doc.size()) && whole.end();
+    for (size_t maxChunk : {1, 2, 7, 64})
+    {
+        std::string events;
+        if (parse(doc, maxChunk, rng, &events) != ok || (ok && events != reference))
+        {
+            printf("events differ when split into chunks of up to %zu bytes: %s\n", maxChunk, doc.c_str());
+            return false;
+        }
+
+        requests::ResultParser split(4);
+        bool splitOk = feedSplit(doc, maxChunk, rng, [&split](const char *data, size_t size) { return split.feed(data, size); }) && split.end();
+        if (splitOk != wholeOk || (splitOk && describe(split) != describe(whole)) || !fieldsIntact(split))
+        {
+            printf("results differ when split into chunks of up to %zu bytes: %s\n", maxChunk, doc.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+static std::string mutate(std::string doc, std::mt19937 &rng)
+{
+    int count = 1 + rng() % 3;
+    for (int i = 0; i < count; i++)
+    {
+        size_t pos = rng() % (doc.size() + 1);
+        char c = MUTATIONS[rng() % (sizeof(MUTATIONS) - 1)];
+        switch (rng() % 3)
+        {
+        case 0:
+            if (pos < doc.size())
+                doc.erase(pos, 1);
+            break;
+        case 1:
+            doc.insert(pos, 1, c);
+            break;
+        default:
+            if (pos < doc.size())
+                doc[pos] = c;
+            break;
+        }
+    }
+    return doc;
+}
+
+// a batched response as the API sends it
+static std::string batch(size_t results)
+{
+    std::string doc = "[";
+    for (size_t i = 0; i < results; i++)
+    {
+        doc += i == 0 ? "" : ", ";
+        doc += R"({"asm": "ADD X0, X1, #0x10", "offset": "", "hex": {"arm64": [true, "20400091"], "arm": [true, "100081E2"], "thumb": [false, "invalid operand for instruction\nADD X0, X1, #0x10\n    ^"]}})";
+    }
+    return doc + "]";
+}
+
+template <typename Parse>
+static void bench(const char *label, const std::string &doc, size_t chunk, Parse parse)
+{
+    size_t rounds = 0;
+    auto start = std::chrono::steady_clock::now();
+    auto elapsed = std::chrono::steady_clock::duration::zero();
+    while (elapsed < std::chrono::milliseconds(500))
+    {
+        if (!parse(doc, chunk))
+        {
+            printf("%s: failed to parse\n", label);
+            return;
+        }
+        rounds++;
+        elapsed = std::chrono::steady_clock::now() - start;
+    }
+    double seconds = std::chrono::duration<double>(elapsed).count();
+    printf("%-14s chunks of %5zu bytes: %8.1f MB/s\n", label, chunk, doc.size() * rounds / seconds / 1e6);
+}
+
+static void benchmark()
+{
+    std::string doc = batch(16);
+    printf("batched response of 16 results, %zu bytes\n", doc.size());
+    for (size_t chunk : {16384, 1024, 64})
+    {
+        bench("json::Parser", doc, chunk, [](const std::string &doc, size_t chunk) {
+            json::Handler handler;
+            json::Parser parser(handler);
+            for (size_t i = 0; i < doc.size(); i += chunk)
+            {
+                if (!parser.feed(doc.data() + i, std::min(chunk, doc.size() - i)))
+                    return false;
+            }
+            return parser.end();
+        });
+        bench("ResultParser", doc, chunk, [](const std::string &doc, size_t chunk) {
+            requests::ResultParser parser(16);
+            for (size_t i = 0; i < doc.size(); i += chunk)
+            {
+                if (!parser.feed(doc.data() + i, std::min(chunk, doc.size() - i)))
+                    return false;
+            }
+            return parser.end() && parser.count() == 16;
+        });
+    }
+}
+
+int main(int argc, char **argv)
+{
+    unsigned long seed = 1;
+    unsigned long iterations = 20000;
+    bool runBench = false;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+            seed = strtoul(argv[++i], nullptr, 10);
+        else if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc)
+            iterations = strtoul(argv[++i], nullptr, 10);
+        else if (strcmp(argv[i], "--bench") == 0)
+            runBench = true;
+        else
+        {
+            printf("usage: %s [--seed N] [--iterations N] [--bench]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    std::mt19937 rng(seed);
+    size_t failed = 0;
+    size_t valid = 0;
+    bool ok;
+
+    std::vector<std::string> docs(std::begin(SEEDS), std::end(SEEDS));
+    docs.push_back(batch(6));
+    for (const auto &doc : docs)
+    {
+        failed += !check(doc, rng, &ok);
+        valid += ok;
+    }
+    for (unsigned long i = 0; i < iterations; i++)
+    {
+        failed += !check(mutate(docs[rng() % docs.size()], rng), rng, &ok);
+        valid += ok;
+    }
+    printf("%zu documents (%zu valid), %zu failed\n", docs.size() + iterations, valid, failed);
+
+    if (runBench)
+        benchmark();
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,130 @@
+// Host benchmark for populating and clearing long lists:
+//   make -C tools list_bench && tools/list_bench [--rows N] [--unbatched N]
+// Fills a Scrollable with rows (appended, and inserted at the top) and empties it again, inside
+// beginUpdate()/endUpdate() and one at a time (fewer rows by default, as that is quadratic), then gives a
+// VirtualList the rows and scrolls it to the end.
+#include "Aether/base/Scrollable.hpp"
+#include "Aether/horizon/list/VirtualList.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+static const int ROW_H = 70;
+
+template <typename F>
+static double time(F &&f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void print(const char *label, double ms, size_t rows)
+{
+    printf("%-30s %6zu rows %10.2f ms %10.3f us/row\n", label, rows, ms, ms * 1000 / rows);
+}
+
+// fills the list (appending, or inserting each row at the top), returning the rows
+static std::vector<Aether::Element *> populate(Aether::Scrollable &list, size_t rows, bool atTop)
+{
+    std::vector<Aether::Element *> added;
+    added.reserve(rows);
+    for (size_t i = 0; i < rows; i++)
+    {
+        Aether::Element *e = new Aether::Element(0, 0, 100, ROW_H);
+        e->setSelectable(true);
+        e->setTouchable(true);
+        if (atTop)
+            list.addElementAfter(e, nullptr);
+        else
+            list.addElement(e);
+        added.push_back(e);
+    }
+    return added;
+}
+
+static bool run(bool batched, size_t rows)
+{
+    const char *mode = batched ? "batched" : "one at a time";
+    for (bool atTop : {false, true})
+    {
+        Aether::Scrollable list(0, 0, 1280, 720);
+        std::vector<Aether::Element *> added;
+        double fill = time([&]() {
+            if (batched)
+                list.beginUpdate();
+            added = populate(list, rows, atTop);
+            if (batched)
+                list.endUpdate();
+        });
+
+        // every row must end up in place, whichever way it was added
+        int expected = (atTop ? added.back() : added.front())->y();
+        for (size_t i = 0; i < rows; i++)
+        {
+            Aether::Element *e = added[atTop ? rows - 1 - i : i];
+            if (e->y() != expected)
+            {
+                printf("FAIL: %s row %zu is at y %d, expected %d\n", mode, i, e->y(), expected);
+                return false;
+            }
+            expected += ROW_H;
+        }
+
+        double clear = time([&]() {
+            if (batched)
+                list.beginUpdate();
+            for (Aether::Element *e : added)
+                list.removeElement(e);
+            if (batched)
+                list.endUpdate();
+        });
+
+        std::string label = std::string(atTop ? "insert at top, " : "append, ") + mode;
+        print(label.c_str(), fill, rows);
+        label = std::string("remove, ") + mode;
+        print(label.c_str(), clear, rows);
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    size_t rows = 10000;
+    size_t unbatched = 2000;
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--rows") && i + 1 < argc)
+            rows = strtoull(argv[++i], nullptr, 10);
+        else if (!strcmp(argv[i], "--unbatched") && i + 1 < argc)
+            unbatched = strtoull(argv[++i], nullptr, 10);
+        else
+        {
+            fprintf(stderr, "usage: %s [--rows N] [--unbatched N]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (rows == 0)
+        rows = 1;
+
+    if (!run(true, rows) || (unbatched > 0 && !run(false, unbatched)))
+        return 1;
+
+    // only the visible rows exist, however many there are
+    Aether::VirtualList virtualList(0, 0, 1280, 720, ROW_H, 20);
+    size_t asked = 0;
+    double set = time([&]() {
+        virtualList.setRows(rows, [&asked](size_t row) {
+            asked++;
+            return "Row " + std::to_string(row);
+        });
+    });
+    print("virtual list, set rows", set, rows);
+    double scroll = time([&]() { virtualList.setTopRow(rows); });
+    print("virtual list, to end", scroll, rows);
+    printf("virtual list asked for %zu rows\n", asked);
+    return 0;
+}
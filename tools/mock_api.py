@@ -0,0 +1,139 @@
+#!/usr/bin/env python3
+"""Local stand-in for the armconverter API, to measure the app's networking against.
+
+Serves plain HTTP and HTTPS at the same time. The HTTPS certificate is self-signed and
+created with openssl on first run. Every request gets a NOP encoding for each line of
+"asm" and each requested arch, in the same shape as the real API.
+
+To point the app at it, put the URL in api_url.txt next to the app on the SD card. For
+HTTPS add the word "insecure", which is only honoured for loopback and LAN addresses:
+    https://192.168.1.10:8443/api/convert insecure
+
+Examples:
+    tools/mock_api.py                                   # HTTP on 8080, HTTPS on 8443
+    tools/mock_api.py --latency 80 --chunk 64           # 80 ms before the reply, 64-byte chunks
+    tools/mock_api.py --size 65536 --gzip               # pad replies to 64 KiB, gzip if accepted
+"""
+import argparse
+import gzip
+import http.server
+import json
+import os
+import socketserver
+import ssl
+import subprocess
+import threading
+import time
+
+# one NOP per line, as the API returns them
+NOPS = {"arm64": "1F2003D5", "arm": "00F020E3", "thumb": "00BF"}
+
+
+def make_handler(args):
+    class Handler(http.server.BaseHTTPRequestHandler):
+        # keep connections open so warm requests can reuse them
+        protocol_version = "HTTP/1.1"
+        # small chunks would otherwise wait on delayed ACKs and hide the client's own timings
+        disable_nagle_algorithm = True
+
+        def do_POST(self):
+            length = int(self.headers.get("Content-Length", 0))
+            try:
+                request = json.loads(self.rfile.read(length) or b"{}")
+            except ValueError:
+                request = {}
+            lines = max(1, len(str(request.get("asm", "")).split("\n")))
+            archs = request.get("arch") or list(NOPS)
+            reply = {"asm": request.get("asm", ""), "offset": request.get("offset", ""),
+                     "hex": {a: [True, NOPS.get(a, "") * lines] for a in archs}}
+            self.reply(reply)
+
+        def do_GET(self):
+            self.reply({"hex": {a: [True, h] for a, h in NOPS.items()}})
+
+        def reply(self, reply):
+            body = json.dumps(reply).encode()
+            # unknown keys are skipped by the app's parser, so padding only adds bytes
+            if len(body) < args.size:
+                reply["padding"] = " " * (args.size - len(body) - len(', "padding": ""'))
+                body = json.dumps(reply).encode()
+
+            time.sleep(args.latency / 1000.0)
+            self.send_response(200)
+            self.send_header("Content-Type", "application/json")
+            if args.gzip and "gzip" in self.headers.get("Accept-Encoding", ""):
+                body = gzip.compress(body)
+                self.send_header("Content-Encoding", "gzip")
+            if args.chunk > 0:
+                self.send_header("Transfer-Encoding", "chunked")
+                self.end_headers()
+                for i in range(0, len(body), args.chunk):
+                    piece = body[i:i + args.chunk]
+                    self.wfile.write(b"%x\r\n%s\r\n" % (len(piece), piece))
+                    self.wfile.flush()
+                    time.sleep(args.chunk_delay / 1000.0)
+                self.wfile.write(b"0\r\n\r\n")
+            else:
+                self.send_header("Content-Length", str(len(body)))
+                self.end_headers()
+                self.wfile.write(body)
+
+        def log_message(self, format, *values):
+            if not args.quiet:
+                super().log_message(format, *values)
+
+    return Handler
+
+
+def certificate(directory):
+    cert = os.path.join(directory, "mock_api.crt")
+    key = os.path.join(directory, "mock_api.key")
+    if not (os.path.exists(cert) and os.path.exists(key)):
+        subprocess.run(["openssl", "req", "-x509", "-newkey", "rsa:2048", "-nodes", "-days", "3650",
+                        "-subj", "/CN=mock_api", "-keyout", key, "-out", cert], check=True, capture_output=True)
+    return cert, key
+
+
+class Server(socketserver.ThreadingMixIn, http.server.HTTPServer):
+    daemon_threads = True
+    allow_reuse_address = True
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--host", default="0.0.0.0", help="address to listen on (default: all)")
+    parser.add_argument("--http-port", type=int, default=8080, help="plain HTTP port, 0 to disable")
+    parser.add_argument("--https-port", type=int, default=8443, help="HTTPS port, 0 to disable")
+    parser.add_argument("--latency", type=float, default=0, help="ms to wait before replying")
+    parser.add_argument("--chunk", type=int, default=0, help="send the body chunked in pieces of this many bytes")
+    parser.add_argument("--chunk-delay", type=float, default=0, help="ms to wait after each chunk")
+    parser.add_argument("--size", type=int, default=0, help="pad each reply to at least this many bytes")
+    parser.add_argument("--gzip", action="store_true", help="gzip replies when the client accepts it")
+    parser.add_argument("--cert-dir", default=os.path.dirname(os.path.abspath(__file__)), help="where the certificate is kept")
+    parser.add_argument("--quiet", action="store_true", help="don't log each request")
+    args = parser.parse_args()
+
+    servers = []
+    if args.http_port:
+        servers.append(Server((args.host, args.http_port), make_handler(args)))
+        print(f"http://{args.host}:{args.http_port}/api/convert")
+    if args.https_port:
+        server = Server((args.host, args.https_port), make_handler(args))
+        context = ssl.SSLContext(ssl.PROTOCOL_TLS_SERVER)
+        context.load_cert_chain(*certificate(args.cert_dir))
+        server.socket = context.wrap_socket(server.socket, server_side=True)
+        servers.append(server)
+        print(f"https://{args.host}:{args.https_port}/api/convert insecure")
+
+    threads = [threading.Thread(target=s.serve_forever, daemon=True) for s in servers]
+    for t in threads:
+        t.start()
+    try:
+        for t in threads:
+            t.join()
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()